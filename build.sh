@@ -10,6 +10,6 @@ vendor_sources="${vendor_dir}/glad/src/glad.c"
 
 test_cflags="${common_flags} -ggdb -D_CRT_SECURE_NO_WARNINGS"
 test_lflags="-lopengl32 -lgdi32 -luser32 -lkernel32"
-test_sources="./src/noe_platform_win32.c ./src/noe_core.c ./src/noe_draw.c ./win32_test.c ${vendor_sources}"
+test_sources="./src/noe_platform_win32.c ./src/noe_core.c ./src/noe_draw.c ./src/noe_text.c ./src/noe_particles.c ./src/noe_loader.c ./src/noe_residency.c ./src/noe_cache.c ./src/noe_rendertexture.c ./src/noe_readback.c ./src/noe_programcache.c ./src/noe_hotreload.c ./src/noe_uniforms.c ./src/noe_shadervariants.c ./src/noe_pipelines.c ./src/noe_transform.c ./win32_test.c ${vendor_sources}"
 
 $cc $test_cflags -o ./test.exe $test_sources $test_lflags
@@ -35,6 +35,11 @@
     #define MAXIMUM_KEYPRESSED_QUEUE 16
 #endif
 
+#ifndef SDF_TEXTURE_INDEX_OFFSET
+    // Texture indices at or above this offset are sampled as signed distance fields by the batch shader
+    #define SDF_TEXTURE_INDEX_OFFSET 8
+#endif
+
 #ifndef SIGN
     #define SIGN(T, a) (((T)(a) > 0) - ((T)(a) < 0))
 #endif 
@@ -135,17 +140,96 @@ typedef struct Rectangle {
 } Rectangle;
 #endif // NOE_SAFE_WIN32_INCLUDE
 
+typedef struct Camera2D {
+    Vector2 offset; // Screen position the target is drawn at
+    Vector2 target; // World position the camera looks at
+    float rotation; // In degrees
+    float zoom;
+} Camera2D;
+
 typedef struct Shader {
     uint32_t ID;
     int *locs;
+    struct _ShaderVariables *variables; // Reflected uniforms and attributes, shared by copies like `locs`
 } Shader;
 
+// Set of shaders built from the same sources with different `#define`s, see `LoadShaderVariants()`
+typedef struct ShaderVariants {
+    uint32_t ID;
+} ShaderVariants;
+
+// Program of a single stage, see `LoadShaderPipeline()`
+typedef struct ShaderStage {
+    uint32_t ID;
+} ShaderStage;
+
+typedef struct ShaderCacheStats {
+    uint32_t hits; // Programs linked from a cached binary
+    uint32_t misses; // Programs without a cached binary
+    uint32_t rejected; // Cached binaries the driver refused, compiled again
+    uint32_t stored;
+} ShaderCacheStats;
+
 typedef struct Texture {
     uint32_t ID;
     uint32_t width, height;
-    uint32_t compAmount; // RGBA = 4, RGB = 3
+    uint32_t compAmount; // RGBA = 4, RGB = 3, GRAY_ALPHA = 2, GRAY = 1
+    int format; // NoePixelFormat
+    uint32_t mipmaps;
+    size_t memorySize; // GPU memory used by every mipmap level, in bytes
+    uint32_t samplerID; // Shared sampler object, 0 uses the parameters of the texture itself
 } Texture;
 
+/**
+ * Describes how `LoadTextureEx()` stores and samples a texture.
+ * A zeroed descriptor gives a mutable RGBA8 texture with generated mipmaps, trilinear filtering and repeat wrapping.
+ */
+typedef struct TextureDesc {
+    int format; // NoePixelFormat of the pixel data, also used as storage format
+    bool srgb; // Store RGB(A) data as sRGB so it is linearized when sampled
+    int mipmaps; // NoeTextureMipmaps
+    int filter; // NoeTextureFilter
+    int wrap; // NoeTextureWrap
+    bool immutable; // Allocate every level at once with `glTexStorage2D()`
+    bool premultiplyAlpha; // Multiply RGB by alpha before uploading, for `BLEND_PREMULTIPLIED`
+} TextureDesc;
+
+// Receives the pixels of `ReadPixelsAsync()`, they are only valid during the call
+typedef void (*ReadbackCallback)(const uint8_t *pixels, uint32_t width, uint32_t height, void *userData);
+
+/**
+ * Framebuffer the batch renderer draws into between `BeginTextureMode()` and `EndTextureMode()`.
+ * Its texture is stored top down like loaded images, shaders without a `u_View` uniform draw it upside down.
+ */
+typedef struct RenderTexture {
+    uint32_t ID; // Framebuffer object
+    Texture texture; // Color attachment, released with `UnloadRenderTexture()` and never `UnloadTexture()`
+    uint32_t depthID; // Depth and stencil renderbuffer, 0 when there is none
+} RenderTexture;
+
+#ifndef NOE_SAFE_WIN32_INCLUDE
+typedef struct NPatchInfo {
+    Rectangle source; // Region of the texture holding the panel
+    int left, top, right, bottom; // Border sizes in texels
+    int layout; // NoeNPatchLayout
+} NPatchInfo;
+
+typedef struct GlyphInfo {
+    int codepoint;
+    Rectangle rect; // Location of the glyph (including padding) in the font atlas
+} GlyphInfo;
+
+typedef struct Font {
+    Texture texture; // Single channel signed distance field atlas
+    uint32_t baseSize; // Glyph height in atlas pixels (excluding padding)
+    uint32_t glyphWidth; // Glyph advance in atlas pixels (excluding padding)
+    uint32_t glyphPadding; // Distance field spread around each glyph in atlas pixels
+    int firstCodepoint;
+    int glyphCount;
+    GlyphInfo *glyphs;
+} Font;
+#endif // NOE_SAFE_WIN32_INCLUDE
+
 typedef struct Color {
     uint8_t r, g, b, a;
 } Color;
@@ -156,6 +240,52 @@ typedef struct Color {
 #define GREEN CLITERAL(Color){ .r = 0x00, .g=0xFF, .b=0x00, .a=0xFF }
 #define BLUE  CLITERAL(Color){ .r = 0x00, .g=0x00, .b=0xFF, .a=0xFF }
 
+/**
+ * Particles are stored as structure of arrays, every array is aligned to
+ * PARTICLE_SIMD_ALIGNMENT and padded to a multiple of PARTICLE_SIMD_WIDTH
+ */
+typedef struct ParticleEmitter {
+    uint32_t capacity;
+    uint32_t count;
+    float *positionX, *positionY;
+    float *velocityX, *velocityY;
+    float *colorR, *colorG, *colorB, *colorA;
+    float *life; // Remaining lifetime in seconds
+
+    Vector2 position;
+    Vector2 gravity;
+    Vector2 velocityMin, velocityMax;
+    float lifetimeMin, lifetimeMax;
+    float fadePerSecond; // Alpha lost per second
+    float size;
+    Color color;
+    uint32_t seed;
+
+    void *memory;
+} ParticleEmitter;
+
+/**
+ * Particles simulated entirely on the GPU with transform feedback, the state
+ * ping-pongs between two vertex buffers and never goes back to the CPU
+ */
+typedef struct GPUParticleSystem {
+    uint32_t capacity;
+    uint32_t vaoIDs[2], vboIDs[2];
+    uint32_t current; // Index of the buffer holding the latest state
+    uint32_t updateProgramID, renderProgramID;
+    int updateLocs[8];
+    int renderLocs[4];
+    float time;
+
+    Vector2 position;
+    Vector2 gravity;
+    Vector2 velocityMin, velocityMax;
+    float lifetimeMin, lifetimeMax;
+    float size;
+    Color color;
+    bool emitting; // Dead particles respawn at `position` while set
+} GPUParticleSystem;
+
 /*******************************
  * Functions
  *******************************/
@@ -168,6 +298,7 @@ char *StringCopy(char *dst, const char *src, size_t length);
 size_t StringLength(const char *str);
 void *MemorySet(void *dst, int value, size_t length);
 void *MemoryCopy(void *dst, const void *src, size_t length);
+int MemoryCompare(const void *a, const void *b, size_t length);
 void *MemoryAlloc(size_t nBytes);
 void MemoryFree(void *ptr);
 void TraceLog(int logLevel, const char *fmt, ...);
@@ -194,6 +325,13 @@ bool IsWindowFullscreen(void);
 
 uint64_t GetTimeMilis(void); // Get time elapsed in milisecond
 
+/// Files
+
+//
+char *LoadFileText(const char *filePath); // Free the result with `MemoryFree()`
+uint8_t *LoadFileData(const char *filePath, size_t *dataSize); // Free the result with `MemoryFree()`
+bool SaveFileData(const char *filePath, const void *data, size_t dataSize);
+
 /// Event handling
 
 //
@@ -214,12 +352,69 @@ bool WindowShouldClose(void);
 
 bool LoadTexture(Texture *result, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount);
 bool LoadTextureFromFile(Texture *texture, const char *filePath, bool flipVerticallyOnLoad);
+bool LoadTextureAsync(Texture *texture, const char *filePath, bool flipVerticallyOnLoad);
+bool IsTextureReady(Texture texture);
+void SetTextureUploadBudget(uint32_t microseconds); // Time `BeginDrawing()` may spend uploading async textures
+void SetTextureLoadPremultiply(bool premultiplyAlpha); // Premultiply alpha of images loaded from files from now on
+bool LoadTextureEx(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, TextureDesc desc);
+void SetTextureSampler(Texture *texture, int filter, int wrap);
+bool LoadTextureCompressed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, int format, uint32_t mipmaps);
+bool IsPixelFormatSupported(int format);
+size_t GetPixelDataSize(uint32_t width, uint32_t height, int format);
+bool LoadTextureStreamed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount);
+void SetTextureMemoryBudget(size_t bytes); // Budget of streamed textures, their mip tails are never evicted
+size_t GetTextureMemoryUsage(void); // GPU memory used by streamed textures
+uint32_t GetTextureResidentLevel(Texture texture); // Largest mipmap level of a streamed texture on the GPU
+bool UpdateTexture(Texture texture, const void *pixels);
+bool UpdateTextureRegion(Texture texture, int x, int y, uint32_t width, uint32_t height, const void *pixels);
+void *BeginTextureUpdate(Texture texture, int x, int y, uint32_t width, uint32_t height);
+bool EndTextureUpdate(void);
 void UnloadTexture(Texture texture);
 
+/// Render textures
+// Released render textures are pooled by size, format and depth attachment and reused by later loads
+
+bool LoadRenderTexture(RenderTexture *target, uint32_t width, uint32_t height);
+bool LoadRenderTextureEx(RenderTexture *target, uint32_t width, uint32_t height, int format, bool depth);
+void UnloadRenderTexture(RenderTexture target);
+void TrimRenderTexturePool(void); // Delete every pooled render texture that is not in use
+void BeginTextureMode(RenderTexture target);
+void EndTextureMode(void);
+bool ReadPixelsAsync(int x, int y, uint32_t width, uint32_t height, ReadbackCallback callback, void *userData);
+void FlushReadbacks(void);
+
+/// Fonts
+
+#ifndef NOE_SAFE_WIN32_INCLUDE
+uint8_t *GenImageSDF(const uint8_t *coverage, uint32_t width, uint32_t height, uint32_t downscale, uint32_t spread,
+        uint32_t *resultWidth, uint32_t *resultHeight);
+bool LoadFontSDF(Font *font, const uint8_t *glyphSheet, uint32_t sheetWidth, uint32_t sheetHeight,
+        uint32_t glyphWidth, uint32_t glyphHeight, int firstCodepoint, uint32_t downscale);
+void UnloadFont(Font font);
+#endif // NOE_SAFE_WIN32_INCLUDE
+
+/// Particles
+
+bool LoadParticleEmitter(ParticleEmitter *emitter, uint32_t capacity);
+void UnloadParticleEmitter(ParticleEmitter *emitter);
+uint32_t EmitParticles(ParticleEmitter *emitter, uint32_t amount);
+void UpdateParticles(ParticleEmitter *emitter, float deltaTime);
+void UpdateParticlesRange(ParticleEmitter *emitter, float deltaTime, uint32_t first, uint32_t amount);
+void RemoveDeadParticles(ParticleEmitter *emitter);
+void DrawParticles(const ParticleEmitter *emitter, Texture texture, Shader shader);
+bool LoadGPUParticleSystem(GPUParticleSystem *system, uint32_t capacity);
+void UnloadGPUParticleSystem(GPUParticleSystem *system);
+void UpdateGPUParticles(GPUParticleSystem *system, float deltaTime);
+void DrawGPUParticles(const GPUParticleSystem *system, Texture texture, Matrix transform);
+
 /// Shaders
 
 bool LoadShader(Shader *result, const char *vertSource, const char *fragSource);
 bool LoadShaderFromFile(Shader *result, const char *vertSourceFilePath, const char *fragSourceFilePath);
+bool LoadShaderAsync(Shader *shader, const char *vertSource, const char *fragSource);
+bool IsShaderReady(Shader shader);
+void SetFallbackShader(Shader shader);
+Shader GetDefaultShader(void);
 void UnloadShader(Shader shader);
 void SetProjectionMatrixUniform(Shader shader, float *matrixData);
 void SetViewMatrixUniform(Shader shader, float *matrixData);
@@ -227,6 +422,29 @@ void SetModelMatrixUniform(Shader shader, float *matrixData);
 void SetShaderUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix);
 int GetShaderUniformLocation(Shader shader, const char *uniformName);
 int GetShaderAttributeLocation(Shader shader, const char *attributeName);
+uint32_t GetShaderUniformID(const char *uniformName); // Hash of the name, compute it once for hot loops
+int GetShaderUniformLocationByID(Shader shader, uint32_t uniformID);
+bool SetShaderUniformByName(Shader shader, const char *uniformName, const void *data, int count);
+bool SetShaderUniformByID(Shader shader, uint32_t uniformID, const void *data, int count);
+bool SetShaderCacheDirectory(const char *directoryPath); // Cache linked program binaries on disk, NULL disables it
+ShaderCacheStats GetShaderCacheStats(void);
+void SetShaderHotReload(bool enabled); // Recompile shaders loaded from files afterwards when their files change
+bool LoadShaderVariants(ShaderVariants *variants, const char *vertSource, const char *fragSource,
+        const char **featureNames, uint32_t featureCount);
+Shader GetShaderVariant(ShaderVariants variants, uint32_t featureMask);
+void PrecompileShaderVariants(ShaderVariants variants, const uint32_t *featureMasks, uint32_t count);
+void UnloadShaderVariants(ShaderVariants variants);
+bool LoadShaderStage(ShaderStage *stage, int stageType, const char *source);
+bool LoadShaderPipeline(Shader *shader, ShaderStage vertStage, ShaderStage fragStage);
+void UnloadShaderStage(ShaderStage stage);
+
+/// Resource cache
+// `LoadTextureFromFile()`, `LoadTextureAsync()` and `LoadShaderFromFile()` share objects loaded from the same path,
+// `UnloadTexture()` and `UnloadShader()` only delete them once every load has been unloaded,
+// an async texture is shared once it is uploaded, loads of the file before that make their own texture
+
+size_t GetResourceCacheMemory(void);
+void TraceResourceCache(void);
 
 ///
 /// Batch Renderer
@@ -238,6 +456,16 @@ int RenderPutVertex(float x, float y, float z, float r, float g, float b, float
 void RenderPutElement(int vertexIndex);
 int RenderEnableTexture(Texture texture);
 void RenderViewport(int x, int y, uint32_t width, uint32_t height);
+void BeginBlendMode(int mode);
+void EndBlendMode(void);
+
+/// Camera
+
+Matrix GetCameraMatrix2D(Camera2D camera);
+Vector2 GetWorldToScreen2D(Vector2 position, Camera2D camera);
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera);
+void BeginMode2D(Camera2D camera);
+void EndMode2D(void);
 
 /// Drawing
 
@@ -248,10 +476,19 @@ void EndDrawing(void);
 void DrawRectangle(Color color, int x, int y, uint32_t w, uint32_t h);
 void DrawTexture(Texture texture, int x, int y, uint32_t w, uint32_t h);
 void DrawTextureEx(Texture texture, Rectangle src, Rectangle dst);
+void DrawTextureNPatch(Texture texture, NPatchInfo info, Rectangle dst);
 void DrawTriangle(Color color, int x1, int y1, int x2, int y2, int x3, int y3);
 void DrawCircle(Color color, int cx, int cy, uint32_t r);
+void DrawText(Font font, Color color, const char *text, int x, int y, uint32_t fontSize);
 #endif // NOE_SAFE_WIN32_INCLUDE
 
+/// Point transforms
+
+// `TransformPoints*()` of nomath.h shared with the worker threads for large arrays
+void TransformPoints2DParallel(const Matrix *matrix, const Vector2 *in, Vector2 *out, size_t count);
+void TransformPoints3DParallel(const Matrix *matrix, const Vector3 *in, Vector3 *out, size_t count);
+void TransformPoints4DParallel(const Matrix *matrix, const Vector4 *in, Vector4 *out, size_t count);
+
 
 /// OpenGL
 
@@ -287,6 +524,66 @@ typedef enum NoeOpenGLSetupFlags {
     OPENGL_SETUP_FORWARD = BIT(5),
 } NoeOpenGLSetupFlags;
 
+typedef enum NoeNPatchLayout {
+    NPATCH_STRETCH = 0, // Edges and center are stretched
+    NPATCH_TILE, // Edges and center are repeated at texel scale, past MAXIMUM_NPATCH_TILES the last tile stretches
+} NoeNPatchLayout;
+
+typedef enum NoePixelFormat {
+    PIXEL_FORMAT_INVALID = 0,
+    PIXEL_FORMAT_R8,
+    PIXEL_FORMAT_RG8,
+    PIXEL_FORMAT_RGB8,
+    PIXEL_FORMAT_RGBA8,
+    PIXEL_FORMAT_BC1_RGB, // 8 bytes per 4x4 block
+    PIXEL_FORMAT_BC1_RGBA, // 8 bytes per 4x4 block
+    PIXEL_FORMAT_BC3_RGBA, // 16 bytes per 4x4 block
+    PIXEL_FORMAT_BC7_RGBA, // 16 bytes per 4x4 block
+    PIXEL_FORMAT_ETC2_RGB, // 8 bytes per 4x4 block
+    PIXEL_FORMAT_ETC2_RGBA, // 16 bytes per 4x4 block
+    // sRGB encoded blocks, decoded to linear when sampled, in the same order as the formats above
+    PIXEL_FORMAT_BC1_RGB_SRGB,
+    PIXEL_FORMAT_BC1_RGBA_SRGB,
+    PIXEL_FORMAT_BC3_RGBA_SRGB,
+    PIXEL_FORMAT_BC7_RGBA_SRGB,
+    PIXEL_FORMAT_ETC2_RGB_SRGB,
+    PIXEL_FORMAT_ETC2_RGBA_SRGB,
+} NoePixelFormat;
+
+typedef enum NoeTextureMipmaps {
+    TEXTURE_MIPMAPS_GENERATE = 0,
+    TEXTURE_MIPMAPS_NONE, // For textures that are never minified like UI and pixel art
+} NoeTextureMipmaps;
+
+typedef enum NoeTextureFilter {
+    TEXTURE_FILTER_TRILINEAR = 0, // Linear between texels and between mipmaps
+    TEXTURE_FILTER_BILINEAR, // Linear between texels, nearest mipmap
+    TEXTURE_FILTER_NEAREST,
+    TEXTURE_FILTER_COUNT,
+} NoeTextureFilter;
+
+typedef enum NoeTextureWrap {
+    TEXTURE_WRAP_REPEAT = 0,
+    TEXTURE_WRAP_CLAMP,
+    TEXTURE_WRAP_MIRRORED_REPEAT,
+    TEXTURE_WRAP_COUNT,
+} NoeTextureWrap;
+
+/**
+ * Blend modes are part of the batch state, changing them splits the batch into draw calls but never flushes it.
+ * With premultiplied textures (`TextureDesc.premultiplyAlpha`, `SetTextureLoadPremultiply()`)
+ * `BLEND_PREMULTIPLIED` covers both alpha and additive sprites: texels with alpha 0 add their color.
+ * Vertex colors stay straight alpha, shaders with a `u_PremultiplyAlpha` bool premultiply them under it.
+ */
+typedef enum NoeBlendMode {
+    BLEND_ALPHA = 0, // Straight alpha, the default
+    BLEND_PREMULTIPLIED, // Color is already multiplied by alpha
+    BLEND_ADDITIVE,
+    BLEND_MULTIPLY, // Destination is multiplied by the source color
+    BLEND_OPAQUE, // Blending disabled
+    BLEND_MODE_COUNT,
+} NoeBlendMode;
+
 typedef enum NoeShaderUniformType {
     INVALID_SHADER_UNIFORM = 0,
     SHADER_UNIFORM_FLOAT, SHADER_UNIFORM_VEC2, SHADER_UNIFORM_VEC3, SHADER_UNIFORM_VEC4,
@@ -295,6 +592,11 @@ typedef enum NoeShaderUniformType {
     SHADER_UNIFORM_MAT3, SHADER_UNIFORM_MAT4, SHADER_UNIFORM_SAMPLER,
 } NoeShaderUniformType;
 
+typedef enum NoeShaderStage {
+    SHADER_STAGE_VERTEX = 0,
+    SHADER_STAGE_FRAGMENT,
+} NoeShaderStage;
+
 typedef enum NoeKeyCode {
     KEY_INVALID            = 0,
 
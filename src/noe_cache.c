@@ -0,0 +1,252 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#ifndef MAXIMUM_CACHED_RESOURCES
+    #define MAXIMUM_CACHED_RESOURCES 256
+#endif
+#ifndef MAXIMUM_RESOURCE_KEY
+    #define MAXIMUM_RESOURCE_KEY 520 // Room for a vertex and a fragment shader path
+#endif
+
+typedef enum _ResourceType {
+    RESOURCE_NONE = 0,
+    RESOURCE_TEXTURE,
+    RESOURCE_SHADER,
+} _ResourceType;
+
+typedef struct _CachedResource {
+    int type;
+    uint32_t hash;
+    uint32_t flags;
+    char key[MAXIMUM_RESOURCE_KEY];
+    uint32_t refCount;
+    size_t memorySize;
+    union {
+        Texture texture;
+        Shader shader;
+    } as;
+} _CachedResource;
+
+static struct {
+    _CachedResource resources[MAXIMUM_CACHED_RESOURCES];
+    uint32_t hits, misses;
+} CACHE = {0};
+
+/**
+ * Normalize `path` so different spellings of the same file share a cache entry:
+ * backslashes become slashes, repeated slashes and `.` segments are dropped and `dir/..` pairs collapse.
+ */
+static bool normalizePath(char *dst, size_t dstSize, const char *path)
+{
+    size_t length = 0;
+    size_t rootLength = 0; // Leading `../` segments and the root slash can not be collapsed
+    if(path[0] == '/' || path[0] == '\\') {
+        dst[length++] = '/';
+        rootLength = 1;
+    }
+
+    const char *p = path;
+    while(*p) {
+        while(*p == '/' || *p == '\\') ++p;
+        const char *segment = p;
+        while(*p && *p != '/' && *p != '\\') ++p;
+        size_t segmentLength = (size_t)(p - segment);
+        if(segmentLength == 0) break;
+        if(segmentLength == 1 && segment[0] == '.') continue;
+
+        if(segmentLength == 2 && segment[0] == '.' && segment[1] == '.' && length > rootLength) {
+            // Drop the previous segment and its separator
+            while(length > rootLength && dst[length - 1] != '/') --length;
+            if(length > rootLength) --length;
+            continue;
+        }
+
+        if(length > 0 && dst[length - 1] != '/') {
+            if(length + 1 >= dstSize) return false;
+            dst[length++] = '/';
+        }
+        if(length + segmentLength >= dstSize) return false;
+        MemoryCopy(&dst[length], segment, segmentLength);
+        length += segmentLength;
+        if(segmentLength == 2 && segment[0] == '.' && segment[1] == '.') rootLength = length;
+    }
+    dst[length] = '\0';
+    return true;
+}
+
+// FNV-1a
+static uint32_t hashKey(const char *key)
+{
+    uint32_t hash = 2166136261u;
+    for(; *key; ++key) {
+        hash ^= (uint8_t)*key;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool keysEqual(const char *a, const char *b)
+{
+    while(*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+static bool makeKey(char *key, const char *firstPath, const char *secondPath)
+{
+    if(!firstPath || !normalizePath(key, MAXIMUM_RESOURCE_KEY, firstPath)) return false;
+    if(!secondPath) return true;
+
+    // Shaders are keyed by both of their stages
+    size_t length = StringLength(key) - 1;
+    if(length + 2 >= MAXIMUM_RESOURCE_KEY) return false;
+    key[length++] = '|';
+    return normalizePath(&key[length], MAXIMUM_RESOURCE_KEY - length, secondPath);
+}
+
+static _CachedResource *findResource(int type, const char *key, uint32_t flags)
+{
+    uint32_t hash = hashKey(key);
+    for(uint32_t i = 0; i < MAXIMUM_CACHED_RESOURCES; ++i) {
+        _CachedResource *resource = &CACHE.resources[i];
+        if(resource->type == type && resource->hash == hash && resource->flags == flags && keysEqual(resource->key, key))
+            return resource;
+    }
+    return NULL;
+}
+
+static _CachedResource *insertResource(int type, const char *key, uint32_t flags)
+{
+    for(uint32_t i = 0; i < MAXIMUM_CACHED_RESOURCES; ++i) {
+        _CachedResource *resource = &CACHE.resources[i];
+        if(resource->type != RESOURCE_NONE) continue;
+        resource->type = type;
+        resource->hash = hashKey(key);
+        resource->flags = flags;
+        MemoryCopy(resource->key, key, StringLength(key));
+        resource->refCount = 1;
+        return resource;
+    }
+    TRACELOG(LOG_WARNING, "Resource cache is full, \"%s\" will not be shared", key);
+    return NULL;
+}
+
+static _CachedResource *findResourceByID(int type, uint32_t ID)
+{
+    if(ID == 0) return NULL;
+    for(uint32_t i = 0; i < MAXIMUM_CACHED_RESOURCES; ++i) {
+        _CachedResource *resource = &CACHE.resources[i];
+        if(resource->type != type) continue;
+        if(type == RESOURCE_TEXTURE && resource->as.texture.ID == ID) return resource;
+        if(type == RESOURCE_SHADER && resource->as.shader.ID == ID) return resource;
+    }
+    return NULL;
+}
+
+bool cacheAcquireTexture(Texture *texture, const char *filePath, uint32_t flags)
+{
+    char key[MAXIMUM_RESOURCE_KEY];
+    if(!makeKey(key, filePath, NULL)) return false;
+    _CachedResource *resource = findResource(RESOURCE_TEXTURE, key, flags);
+    if(!resource) {
+        CACHE.misses += 1;
+        return false;
+    }
+    CACHE.hits += 1;
+    resource->refCount += 1;
+    *texture = resource->as.texture;
+    return true;
+}
+
+void cacheInsertTexture(Texture texture, const char *filePath, uint32_t flags)
+{
+    char key[MAXIMUM_RESOURCE_KEY];
+    if(!makeKey(key, filePath, NULL)) return;
+    // Two async loads of a file can both finish, the later texture stays unshared
+    if(findResource(RESOURCE_TEXTURE, key, flags)) return;
+    _CachedResource *resource = insertResource(RESOURCE_TEXTURE, key, flags);
+    if(!resource) return;
+    resource->as.texture = texture;
+    resource->memorySize = texture.memorySize;
+}
+
+bool cacheReleaseTexture(uint32_t textureID)
+{
+    _CachedResource *resource = findResourceByID(RESOURCE_TEXTURE, textureID);
+    if(!resource) return false;
+    resource->refCount -= 1;
+    if(resource->refCount > 0) return true;
+    resource->type = RESOURCE_NONE;
+    return false;
+}
+
+bool cacheAcquireShader(Shader *shader, const char *vertSourceFilePath, const char *fragSourceFilePath)
+{
+    char key[MAXIMUM_RESOURCE_KEY];
+    if(!makeKey(key, vertSourceFilePath, fragSourceFilePath)) return false;
+    _CachedResource *resource = findResource(RESOURCE_SHADER, key, 0);
+    if(!resource) {
+        CACHE.misses += 1;
+        return false;
+    }
+    CACHE.hits += 1;
+    resource->refCount += 1;
+    *shader = resource->as.shader;
+    return true;
+}
+
+void cacheInsertShader(Shader shader, const char *vertSourceFilePath, const char *fragSourceFilePath)
+{
+    char key[MAXIMUM_RESOURCE_KEY];
+    if(!makeKey(key, vertSourceFilePath, fragSourceFilePath)) return;
+    _CachedResource *resource = insertResource(RESOURCE_SHADER, key, 0);
+    if(!resource) return;
+
+    // The driver does not expose program memory, the binary size is the closest estimate
+    int binaryLength = 0;
+    glGetProgramiv(shader.ID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    resource->as.shader = shader;
+    resource->memorySize = binaryLength > 0 ? (size_t)binaryLength : 0;
+}
+
+bool cacheReleaseShader(uint32_t shaderID)
+{
+    _CachedResource *resource = findResourceByID(RESOURCE_SHADER, shaderID);
+    if(!resource) return false;
+    resource->refCount -= 1;
+    if(resource->refCount > 0) return true;
+    resource->type = RESOURCE_NONE;
+    return false;
+}
+
+size_t GetResourceCacheMemory(void)
+{
+    size_t result = 0;
+    for(uint32_t i = 0; i < MAXIMUM_CACHED_RESOURCES; ++i) {
+        if(CACHE.resources[i].type != RESOURCE_NONE) result += CACHE.resources[i].memorySize;
+    }
+    return result;
+}
+
+// Log every cached resource with its reference count and memory, followed by the totals
+void TraceResourceCache(void)
+{
+    uint32_t count = 0;
+    for(uint32_t i = 0; i < MAXIMUM_CACHED_RESOURCES; ++i) {
+        _CachedResource *resource = &CACHE.resources[i];
+        if(resource->type == RESOURCE_NONE) continue;
+        TRACELOG(LOG_INFO, "%s id %u refs %u %zu bytes \"%s\"%s%s",
+                resource->type == RESOURCE_TEXTURE ? "Texture" : "Shader",
+                resource->type == RESOURCE_TEXTURE ? resource->as.texture.ID : resource->as.shader.ID,
+                resource->refCount, resource->memorySize, resource->key,
+                (resource->flags & TEXTURE_CACHE_FLIPPED) ? " (flipped)" : "",
+                (resource->flags & TEXTURE_CACHE_PREMULTIPLIED) ? " (premultiplied)" : "");
+        count += 1;
+    }
+    TRACELOG(LOG_INFO, "Resource cache: %u resources, %zu bytes, %u hits, %u misses",
+            count, GetResourceCacheMemory(), CACHE.hits, CACHE.misses);
+}
@@ -54,10 +54,10 @@
 #ifndef MODEL_MATRIX_SHADER_UNIFORM_NAME
     #define MODEL_MATRIX_SHADER_UNIFORM_NAME "u_Model"
 #endif // MODEL_MATRIX_SHADER_UNIFORM_NAME
+#ifndef PREMULTIPLY_ALPHA_SHADER_UNIFORM_NAME
+    #define PREMULTIPLY_ALPHA_SHADER_UNIFORM_NAME "u_PremultiplyAlpha" // Optional, a bool set per draw call
+#endif // PREMULTIPLY_ALPHA_SHADER_UNIFORM_NAME
 
-#ifndef MAXIMUM_SHADER_LOCS
-    #define MAXIMUM_SHADER_LOCS 16
-#endif
 #ifndef MAXIMUM_BATCH_RENDERER_VERTICES
     #define MAXIMUM_BATCH_RENDERER_VERTICES (32*1024)
 #endif
@@ -67,6 +67,23 @@
 #ifndef MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES
     #define MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES 8
 #endif
+#ifndef MAXIMUM_BATCH_RENDERER_DRAW_CALLS
+    #define MAXIMUM_BATCH_RENDERER_DRAW_CALLS 256
+#endif
+#ifndef TEXTURE_UPLOAD_BUFFER_COUNT
+    #define TEXTURE_UPLOAD_BUFFER_COUNT 3
+#endif
+#ifndef MAXIMUM_PENDING_SHADERS
+    #define MAXIMUM_PENDING_SHADERS 64
+#endif
+#ifndef MAXIMUM_PRESERVED_UNIFORMS
+    #define MAXIMUM_PRESERVED_UNIFORMS 32
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (*_PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(uint32_t count);
 
 typedef struct _WindowState {
     const char *title;
@@ -77,12 +94,38 @@ typedef struct _WindowState {
     bool shouldClose;
 } _WindowState;
 
-typedef struct _RenderVertex {
-    struct { float x, y, z; } pos;
-    struct { float r, g, b, a; } color;
-    struct { float u, v; } texCoords;
-    float textureIndex;
-} _RenderVertex;
+/**
+ * A range of the batch drawn with the same render state,
+ * it ends where the next draw call (or the batch) ends
+ */
+typedef struct _RenderDrawCall {
+    uint32_t vertexOffset;
+    uint32_t elementOffset;
+    Matrix view;
+    int blendMode;
+} _RenderDrawCall;
+
+/**
+ * Pixel unpack buffer used for texture uploads, the fence is signaled
+ * once the GPU is done reading the last upload out of it
+ */
+typedef struct _RenderUploadBuffer {
+    uint32_t ID;
+    size_t capacity;
+    GLsync fence;
+} _RenderUploadBuffer;
+
+/**
+ * Program submitted by `LoadShaderAsync()` whose compile and link status was not asked for yet,
+ * the sources are kept for the program cache
+ */
+typedef struct _PendingShader {
+    Shader *shader;
+    uint32_t programID, vertModule, fragModule;
+    char *vertSource, *fragSource;
+    float matrices[3][16]; // Projection, view and model matrices set before the program was linked
+    uint32_t setMatrices; // Bit per entry of `matrices`
+} _PendingShader;
 
 typedef struct _BatchRendererState {
     struct {
@@ -90,6 +133,7 @@ typedef struct _BatchRendererState {
     } config;
 
     uint32_t vaoID, vboID, eboID;
+    Shader builtinShader; // Compiled from `BUILTIN_VERT_SOURCE` and `BUILTIN_FRAG_SOURCE`
     Shader defaultShader;
     struct {
         _RenderVertex data[MAXIMUM_BATCH_RENDERER_VERTICES];
@@ -101,8 +145,43 @@ typedef struct _BatchRendererState {
     } elements;
     struct {
         uint32_t data[MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES];
+        uint32_t samplers[MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES];
         uint32_t count;
     } activeTextureIDs;
+    // Sampler objects created on first use, indexed by filter, wrap and whether mipmaps are sampled
+    uint32_t samplers[TEXTURE_FILTER_COUNT][TEXTURE_WRAP_COUNT][2];
+    struct {
+        _RenderDrawCall data[MAXIMUM_BATCH_RENDERER_DRAW_CALLS];
+        uint32_t count;
+    } drawCalls;
+    struct {
+        Matrix view;
+        float viewScale; // Zoom of the current camera
+        int blendMode;
+        bool cullEnabled;
+        float cullMinX, cullMinY, cullMaxX, cullMaxY; // Visible world area of the current camera
+    } state;
+    struct {
+        uint32_t width, height; // Size of the bound render texture, 0 while drawing into the window
+    } target;
+    Shader lastShader;
+    struct {
+        _PendingShader data[MAXIMUM_PENDING_SHADERS];
+        uint32_t count;
+        bool checkedParallel, parallel; // GL_KHR_parallel_shader_compile lets the status be polled
+    } pendingShaders;
+    struct {
+        _RenderUploadBuffer buffers[TEXTURE_UPLOAD_BUFFER_COUNT];
+        uint32_t current;
+        uint32_t imageBuffer; // Mapped by `renderMapTextureImage()`
+        struct {
+            bool active;
+            uint32_t buffer; // Index in `buffers`, it stays mapped until `EndTextureUpdate()`
+            uint32_t textureID, compAmount;
+            int x, y;
+            uint32_t width, height;
+        } mapped; // Update started by `BeginTextureUpdate()`
+    } upload;
 } _BatchRendererState;
 
 typedef struct _ApplicationState {
@@ -161,6 +240,16 @@ void *MemoryCopy(void *dst, const void *src, size_t length)
     return dst;
 }
 
+int MemoryCompare(const void *a, const void *b, size_t length)
+{
+    for(size_t i = 0; i < length; ++i) {
+        uint8_t x = CAST(const uint8_t *, a)[i];
+        uint8_t y = CAST(const uint8_t *, b)[i];
+        if(x != y) return x < y ? -1 : 1;
+    }
+    return 0;
+}
+
 char *StringCopy(char *dst, const char *src, size_t length)
 {
     for(size_t i = 0; i < length; ++i)
@@ -207,6 +296,91 @@ void platformSetWindowFullscreen(bool isFullscreen);
 void SwapGLBuffer(void);
 uint64_t GetTimeMilis(void);
 
+// The default shader is built into the library, so drawing works without loading any file
+static const char BUILTIN_VERT_SOURCE[] =
+    "#version 330 core\n"
+    "\n"
+    "layout (location=0) in vec3 a_Position;\n"
+    "layout (location=1) in vec4 a_Color;\n"
+    "layout (location=2) in vec2 a_TexCoords;\n"
+    "layout (location=3) in float a_TextureIndex;\n"
+    "\n"
+    "out vec4 v_Color;\n"
+    "out vec2 v_TexCoords;\n"
+    "out float v_TextureIndex;\n"
+    "\n"
+    "uniform mat4 u_Projection;\n"
+    "uniform mat4 u_View;\n"
+    "\n"
+    "void main() {\n"
+    "    gl_Position = u_Projection * u_View * vec4(a_Position, 1.0);\n"
+    "    v_Color = a_Color;\n"
+    "    v_TexCoords = a_TexCoords;\n"
+    "    v_TextureIndex = a_TextureIndex;\n"
+    "}\n";
+
+static const char BUILTIN_FRAG_SOURCE[] =
+    "#version 330 core\n"
+    "\n"
+    "layout (location=0) out vec4 o_FragColor;\n"
+    "\n"
+    "in vec4 v_Color;\n"
+    "in vec2 v_TexCoords;\n"
+    "in float v_TextureIndex;\n"
+    "\n"
+    "uniform sampler2D u_Textures[8];\n"
+    "uniform bool u_PremultiplyAlpha; // Set by `RenderFlush()` for `BLEND_PREMULTIPLIED` draw calls\n"
+    "\n"
+    "// Sampler arrays can only be indexed with constant expressions in GLSL 3.30\n"
+    "vec4 sampleTexture(int index, vec2 uv) {\n"
+    "    switch(index) {\n"
+    "        case 0: return texture(u_Textures[0], uv);\n"
+    "        case 1: return texture(u_Textures[1], uv);\n"
+    "        case 2: return texture(u_Textures[2], uv);\n"
+    "        case 3: return texture(u_Textures[3], uv);\n"
+    "        case 4: return texture(u_Textures[4], uv);\n"
+    "        case 5: return texture(u_Textures[5], uv);\n"
+    "        case 6: return texture(u_Textures[6], uv);\n"
+    "        case 7: return texture(u_Textures[7], uv);\n"
+    "    }\n"
+    "    return vec4(1.0);\n"
+    "}\n"
+    "\n"
+    "void main() {\n"
+    "    int index = int(v_TextureIndex);\n"
+    "    vec4 color = v_Color;\n"
+    "    if(u_PremultiplyAlpha) color.rgb *= color.a;\n"
+    "    if(index < 0) {\n"
+    "        o_FragColor = color;\n"
+    "    } else if(index >= 8) {\n"
+    "        // Signed distance field (SDF_TEXTURE_INDEX_OFFSET): the edge lies at 0.5\n"
+    "        float dist = sampleTexture(index - 8, v_TexCoords.xy).r;\n"
+    "        float width = max(fwidth(dist), 1e-4);\n"
+    "        float alpha = smoothstep(0.5 - width, 0.5 + width, dist);\n"
+    "        o_FragColor = vec4(color.rgb * (u_PremultiplyAlpha ? alpha : 1.0), color.a * alpha);\n"
+    "    } else {\n"
+    "        o_FragColor = sampleTexture(index, v_TexCoords.xy) * color;\n"
+    "    }\n"
+    "}\n";
+
+// Size in pixels of what the batch draws into, the bound render texture or else the window
+static void renderGetTargetSize(float *width, float *height)
+{
+    bool hasTarget = APP.renderer.target.width > 0 && APP.renderer.target.height > 0;
+    *width = (float)(hasTarget ? APP.renderer.target.width : APP.window.width);
+    *height = (float)(hasTarget ? APP.renderer.target.height : APP.window.height);
+}
+
+// Target size in pixels with a top left origin, kept in step with the window and render textures
+static void setBuiltinShaderProjection(void)
+{
+    if(!IsShaderReady(APP.renderer.builtinShader)) return;
+    float width, height;
+    renderGetTargetSize(&width, &height);
+    Matrix projection = MatrixOrthographic(0.0f, width, height, 0.0f, -1.0f, 1.0f);
+    SetProjectionMatrixUniform(APP.renderer.builtinShader, projection.elements);
+}
+
 bool initBatchRenderer(void)
 {
     gladLoadGL();
@@ -215,12 +389,22 @@ bool initBatchRenderer(void)
     APP.renderer.vertices.count = 0;
     APP.renderer.elements.count = 0;
     APP.renderer.activeTextureIDs.count = 0;
+    APP.renderer.state.view = MatrixCreate(1.0f);
+    APP.renderer.state.viewScale = 1.0f;
+    APP.renderer.state.cullEnabled = false;
+    APP.renderer.state.blendMode = BLEND_ALPHA;
+    APP.renderer.drawCalls.count = 1;
+    APP.renderer.drawCalls.data[0] = CLITERAL(_RenderDrawCall){
+        .view = APP.renderer.state.view,
+        .blendMode = APP.renderer.state.blendMode,
+    };
 
     glGenBuffers(1, &APP.renderer.vboID);
     glBindBuffer(GL_ARRAY_BUFFER, APP.renderer.vboID);
     glBufferData(GL_ARRAY_BUFFER, sizeof(APP.renderer.vertices.data), NULL, GL_DYNAMIC_DRAW);
 
     if(APP.renderer.config.supportVAO) {
+        glGenVertexArrays(1, &APP.renderer.vaoID);
         glBindVertexArray(APP.renderer.vaoID);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(_RenderVertex), (void*)offsetof(_RenderVertex, pos));
@@ -235,15 +419,33 @@ bool initBatchRenderer(void)
     glGenBuffers(1, &APP.renderer.eboID);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, APP.renderer.eboID);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(APP.renderer.elements.data), NULL, GL_DYNAMIC_DRAW);
+    if(APP.renderer.config.supportVAO) glBindVertexArray(0);
+
+    // Linked from the program cache when `SetShaderCacheDirectory()` was called before `InitApplication()`
+    if(LoadShader(&APP.renderer.builtinShader, BUILTIN_VERT_SOURCE, BUILTIN_FRAG_SOURCE)) {
+        setBuiltinShaderProjection();
+    } else {
+        TRACELOG(LOG_WARNING, "Failed to compile the built-in shader, `RenderFlush()` needs a shader");
+        APP.renderer.builtinShader = CLITERAL(Shader){0};
+    }
+    APP.renderer.defaultShader = APP.renderer.builtinShader;
 
     return true;
 }
 
 void deinitBatchRenderer(void)
 {
+    if(APP.renderer.builtinShader.ID) UnloadShader(APP.renderer.builtinShader);
+    APP.renderer.builtinShader = APP.renderer.defaultShader = CLITERAL(Shader){0};
     if(APP.renderer.config.supportVAO) glDeleteVertexArrays(1, &APP.renderer.vaoID);
     glDeleteBuffers(1, &APP.renderer.eboID);
     glDeleteBuffers(1, &APP.renderer.vboID);
+    glDeleteSamplers(sizeof(APP.renderer.samplers)/sizeof(uint32_t), &APP.renderer.samplers[0][0][0]);
+    for(uint32_t i = 0; i < TEXTURE_UPLOAD_BUFFER_COUNT; ++i) {
+        _RenderUploadBuffer *buffer = &APP.renderer.upload.buffers[i];
+        if(buffer->fence) glDeleteSync(buffer->fence);
+        if(buffer->ID) glDeleteBuffers(1, &buffer->ID);
+    }
 }
 
 bool InitApplication(void)
@@ -270,6 +472,9 @@ bool InitApplication(void)
     TRACELOG(LOG_INFO, "Initializing batch renderer success (OpenGL)");
 #endif
 
+    if(!platformInitWorkers(MAXIMUM_WORKER_THREADS))
+        TRACELOG(LOG_WARNING, "Worker threads are unavailable, async loading is disabled");
+
     TRACELOG(LOG_INFO, "Initializing application success");
     APP.initialized = true;
     return true;
@@ -280,11 +485,34 @@ _InputManager *getApplicationInputManager(void)
     return &APP.inputs;
 }
 
+void setApplicationWindowSize(uint32_t width, uint32_t height)
+{
+    if(width == 0 || height == 0) return; // Minimized
+    if(width == APP.window.width && height == APP.window.height) return;
+    APP.window.width = width;
+    APP.window.height = height;
+    setBuiltinShaderProjection();
+}
+
+void renderSetTargetSize(uint32_t width, uint32_t height)
+{
+    APP.renderer.target.width = width;
+    APP.renderer.target.height = height;
+    setBuiltinShaderProjection();
+}
+
 
 void DeinitApplication(void)
 {
     if(!APP.initialized) return;
+    platformDeinitWorkers();
+    deinitAsyncTextureLoads();
 #ifndef NOE_PLATFORM_WIN32
+    deinitReadbacks();
+    deinitRenderTexturePool();
+    deinitShaderHotReload();
+    deinitShaderVariants();
+    deinitShaderPipelines();
     deinitBatchRenderer();
 #endif
     platformDeinit();
@@ -307,8 +535,7 @@ void SetWindowSize(uint32_t width, uint32_t height)
     TRACELOG(LOG_ERROR, "`SetWindowVisible()` only works on Desktop Platform");
 #else
     NOE_REQUIRE_INIT_OR_RETURN_VOID("`SetWindowSize()` requires you to call `InitApplication()`");
-    APP.window.width = width;
-    APP.window.height = height;
+    setApplicationWindowSize(width, height);
 #endif
 }
 
@@ -474,8 +701,51 @@ void RenderClear(float r, float g, float b, float a)
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+static void renderResetBatch(void)
+{
+    APP.renderer.vertices.count = 0;
+    APP.renderer.elements.count = 0;
+    APP.renderer.activeTextureIDs.count = 0;
+    APP.renderer.drawCalls.count = 1;
+    APP.renderer.drawCalls.data[0] = CLITERAL(_RenderDrawCall){
+        .view = APP.renderer.state.view,
+        .blendMode = APP.renderer.state.blendMode,
+    };
+}
+
+// Set the OpenGL blend state of a `NoeBlendMode`, the alpha of the destination is kept as coverage
+static void renderApplyBlendMode(int mode)
+{
+    if(mode == BLEND_OPAQUE) {
+        glDisable(GL_BLEND);
+        return;
+    }
+    glEnable(GL_BLEND);
+    glBlendEquation(GL_FUNC_ADD);
+    switch(mode) {
+        case BLEND_PREMULTIPLIED: glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+        case BLEND_ADDITIVE: glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ZERO, GL_ONE); break;
+        case BLEND_MULTIPLY: glBlendFuncSeparate(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE); break;
+        default: glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+    }
+}
+
+void renderApplyCurrentBlendMode(void)
+{
+    renderApplyBlendMode(APP.renderer.state.blendMode);
+}
+
 void RenderFlush(Shader shader)
 {
+    APP.renderer.lastShader = shader;
+    if(!IsShaderReady(shader)) {
+        if(!IsShaderReady(APP.renderer.defaultShader)) {
+            renderResetBatch();
+            return;
+        }
+        shader = APP.renderer.defaultShader;
+    }
+
     if(APP.renderer.config.supportVAO) glBindVertexArray(APP.renderer.vaoID);
     if(APP.renderer.vertices.count > 0) {
         glBindBuffer(GL_ARRAY_BUFFER, APP.renderer.vboID);
@@ -489,7 +759,7 @@ void RenderFlush(Shader shader)
     }
     if(APP.renderer.config.supportVAO) glBindVertexArray(0);
 
-    glUseProgram(shader.ID);
+    pipelineBindShader(shader);
     if(APP.renderer.config.supportVAO) glBindVertexArray(APP.renderer.vaoID);
     else {
         glBindBuffer(GL_ARRAY_BUFFER, APP.renderer.vboID); 
@@ -517,15 +787,57 @@ void RenderFlush(Shader shader)
     for(int i = 0; i < (int)APP.renderer.activeTextureIDs.count; ++i) {
         glActiveTexture(GL_TEXTURE0 + i);
         glBindTexture(GL_TEXTURE_2D, APP.renderer.activeTextureIDs.data[i]);
+        glBindSampler(i, APP.renderer.activeTextureIDs.samplers[i]);
     }
 
-    glUniform1iv(shader.locs[TEXTURE_SAMPLERS_SHADER_UNIFORM_LOCATION],
-            MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES, textureUnits);
+    // Staged like the uniforms of the app, so a program keeps its sampler units after the first flush
+    if(!stageShaderUniform(shader, shader.locs[TEXTURE_SAMPLERS_SHADER_UNIFORM_LOCATION], SHADER_UNIFORM_SAMPLER,
+                textureUnits, MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES, false)) {
+        uploadShaderUniform(shader, shader.locs[TEXTURE_SAMPLERS_SHADER_UNIFORM_LOCATION], SHADER_UNIFORM_SAMPLER,
+                textureUnits, MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES);
+    }
+    uploadShaderUniforms(shader);
+
+    int blendMode = -1;
+    int premultiplyLocation = GetShaderUniformLocation(shader, PREMULTIPLY_ALPHA_SHADER_UNIFORM_NAME);
+    for(uint32_t i = 0; i < APP.renderer.drawCalls.count; ++i) {
+        const _RenderDrawCall *call = &APP.renderer.drawCalls.data[i];
+        bool isLast = (i + 1) == APP.renderer.drawCalls.count;
+        uint32_t vertexEnd = isLast ? APP.renderer.vertices.count : call[1].vertexOffset;
+        uint32_t elementEnd = isLast ? APP.renderer.elements.count : call[1].elementOffset;
+        if(vertexEnd == call->vertexOffset && elementEnd == call->elementOffset) continue;
+
+        if(call->blendMode != blendMode) {
+            renderApplyBlendMode(call->blendMode);
+            blendMode = call->blendMode;
+            if(premultiplyLocation >= 0) {
+                // Vertex colors are straight alpha, the shader premultiplies them for premultiplied blending
+                int premultiply = blendMode == BLEND_PREMULTIPLIED;
+                if(stageShaderUniform(shader, premultiplyLocation, SHADER_UNIFORM_INT, &premultiply, 1, false)) uploadShaderUniforms(shader);
+                else uploadShaderUniform(shader, premultiplyLocation, SHADER_UNIFORM_INT, &premultiply, 1);
+            }
+        }
 
-    if(APP.renderer.elements.count > 0) {
-        glDrawElements(GL_TRIANGLES, APP.renderer.elements.count, GL_UNSIGNED_INT, 0);
-    } else {
-        glDrawArrays(GL_TRIANGLES, 0, APP.renderer.vertices.count);
+        int viewLocation = shader.locs[VIEW_MATRIX_SHADER_UNIFORM_LOCATION];
+        if(viewLocation >= 0) {
+            Matrix view = call->view;
+            if(APP.renderer.target.height > 0) {
+                // Texture rows go top down but framebuffer rows bottom up, flipped so render textures draw upright
+                view = MatrixScale(view, CLITERAL(Vector3){ .x=1.0f, .y=-1.0f, .z=1.0f });
+                view = MatrixTranslate(view, CLITERAL(Vector3){ .x=0.0f, .y=(float)APP.renderer.target.height, .z=0.0f });
+            }
+            if(stageShaderUniform(shader, viewLocation, SHADER_UNIFORM_MAT4, view.elements, 1, false)) uploadShaderUniforms(shader);
+            else uploadShaderUniform(shader, viewLocation, SHADER_UNIFORM_MAT4, view.elements, 1);
+        }
+
+        if(APP.renderer.elements.count > 0) {
+            if(elementEnd > call->elementOffset) {
+                glDrawElements(GL_TRIANGLES, elementEnd - call->elementOffset, GL_UNSIGNED_INT, 
+                        (void *)(sizeof(uint32_t)*call->elementOffset));
+            }
+        } else if(vertexEnd > call->vertexOffset) {
+            glDrawArrays(GL_TRIANGLES, call->vertexOffset, vertexEnd - call->vertexOffset);
+        }
     }
 
     if(APP.renderer.config.supportVAO) glBindVertexArray(0);
@@ -533,11 +845,142 @@ void RenderFlush(Shader shader)
         if(APP.renderer.elements.count > 0) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
-    glUseProgram(0);
+    pipelineUnbindShader(shader);
 
-    APP.renderer.vertices.count = 0;
-    APP.renderer.elements.count = 0;
-    APP.renderer.activeTextureIDs.count = 0;
+    renderResetBatch();
+}
+
+// `RenderFlush()` falls back to the default shader when no shader was flushed with yet
+void renderFlushBatch(void)
+{
+    if(APP.renderer.vertices.count == 0) return;
+    RenderFlush(APP.renderer.lastShader);
+}
+
+// Start a new draw call with the current render state, an empty trailing draw call is reused
+static void renderBeginDrawCall(void)
+{
+    _RenderDrawCall *last = &APP.renderer.drawCalls.data[APP.renderer.drawCalls.count - 1];
+    if(last->vertexOffset == APP.renderer.vertices.count && last->elementOffset == APP.renderer.elements.count) {
+        last->view = APP.renderer.state.view;
+        last->blendMode = APP.renderer.state.blendMode;
+        return;
+    }
+
+    if(APP.renderer.drawCalls.count == MAXIMUM_BATCH_RENDERER_DRAW_CALLS) {
+        if(!IsShaderReady(APP.renderer.lastShader) && !IsShaderReady(APP.renderer.defaultShader)) {
+            TRACELOG(LOG_WARNING, "No shader is ready to draw the full batch, dropping it");
+        }
+        // Flushing starts a new batch with the current state, queued draw calls keep theirs
+        RenderFlush(APP.renderer.lastShader);
+        return;
+    }
+
+    APP.renderer.drawCalls.data[APP.renderer.drawCalls.count++] = CLITERAL(_RenderDrawCall){
+        .vertexOffset = APP.renderer.vertices.count,
+        .elementOffset = APP.renderer.elements.count,
+        .view = APP.renderer.state.view,
+        .blendMode = APP.renderer.state.blendMode,
+    };
+}
+
+void BeginBlendMode(int mode)
+{
+    if(mode < 0 || mode >= BLEND_MODE_COUNT) {
+        TRACELOG(LOG_WARNING, "Unknown blend mode %d", mode);
+        return;
+    }
+    if(APP.renderer.state.blendMode == mode) return;
+    APP.renderer.state.blendMode = mode;
+    renderBeginDrawCall();
+}
+
+void EndBlendMode(void)
+{
+    BeginBlendMode(BLEND_ALPHA);
+}
+
+bool renderIsRectCulled(float x, float y, float width, float height)
+{
+    if(!APP.renderer.state.cullEnabled) return false;
+    return (x + width) < APP.renderer.state.cullMinX || x > APP.renderer.state.cullMaxX ||
+        (y + height) < APP.renderer.state.cullMinY || y > APP.renderer.state.cullMaxY;
+}
+
+Matrix GetCameraMatrix2D(Camera2D camera)
+{
+    // screen = offset + rotate(zoom*(world - target)), stored column major
+    float c = cosf(DEG2RAD(camera.rotation))*camera.zoom;
+    float s = sinf(DEG2RAD(camera.rotation))*camera.zoom;
+    Matrix result = MatrixCreate(1.0f);
+    result.elements[0] = c;
+    result.elements[1] = s;
+    result.elements[4] = -s;
+    result.elements[5] = c;
+    result.elements[12] = camera.offset.x - (c*camera.target.x - s*camera.target.y);
+    result.elements[13] = camera.offset.y - (s*camera.target.x + c*camera.target.y);
+    return result;
+}
+
+Vector2 GetWorldToScreen2D(Vector2 position, Camera2D camera)
+{
+    Matrix m = GetCameraMatrix2D(camera);
+    return CLITERAL(Vector2){
+        .x = m.elements[0]*position.x + m.elements[4]*position.y + m.elements[12],
+        .y = m.elements[1]*position.x + m.elements[5]*position.y + m.elements[13],
+    };
+}
+
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera)
+{
+    if(camera.zoom == 0.0f) return camera.target;
+    float c = cosf(DEG2RAD(camera.rotation))/camera.zoom;
+    float s = sinf(DEG2RAD(camera.rotation))/camera.zoom;
+    float x = position.x - camera.offset.x;
+    float y = position.y - camera.offset.y;
+    return CLITERAL(Vector2){
+        .x = camera.target.x + c*x + s*y,
+        .y = camera.target.y - s*x + c*y,
+    };
+}
+
+void BeginMode2D(Camera2D camera)
+{
+    APP.renderer.state.view = GetCameraMatrix2D(camera);
+
+    // Visible world area is the bounding box of the corners of the target
+    float width, height;
+    renderGetTargetSize(&width, &height);
+    Vector2 corners[4] = {
+        GetScreenToWorld2D(CLITERAL(Vector2){ .x=0.0f, .y=0.0f }, camera),
+        GetScreenToWorld2D(CLITERAL(Vector2){ .x=width, .y=0.0f }, camera),
+        GetScreenToWorld2D(CLITERAL(Vector2){ .x=width, .y=height }, camera),
+        GetScreenToWorld2D(CLITERAL(Vector2){ .x=0.0f, .y=height }, camera),
+    };
+    APP.renderer.state.cullMinX = APP.renderer.state.cullMaxX = corners[0].x;
+    APP.renderer.state.cullMinY = APP.renderer.state.cullMaxY = corners[0].y;
+    for(int i = 1; i < 4; ++i) {
+        if(corners[i].x < APP.renderer.state.cullMinX) APP.renderer.state.cullMinX = corners[i].x;
+        if(corners[i].x > APP.renderer.state.cullMaxX) APP.renderer.state.cullMaxX = corners[i].x;
+        if(corners[i].y < APP.renderer.state.cullMinY) APP.renderer.state.cullMinY = corners[i].y;
+        if(corners[i].y > APP.renderer.state.cullMaxY) APP.renderer.state.cullMaxY = corners[i].y;
+    }
+    APP.renderer.state.cullEnabled = camera.zoom != 0.0f;
+    APP.renderer.state.viewScale = fabsf(camera.zoom);
+    renderBeginDrawCall();
+}
+
+void EndMode2D(void)
+{
+    APP.renderer.state.view = MatrixCreate(1.0f);
+    APP.renderer.state.viewScale = 1.0f;
+    APP.renderer.state.cullEnabled = false;
+    renderBeginDrawCall();
+}
+
+float renderGetViewScale(void)
+{
+    return APP.renderer.state.viewScale;
 }
 
 void RenderViewport(int x, int y, uint32_t width, uint32_t height)
@@ -547,8 +990,18 @@ void RenderViewport(int x, int y, uint32_t width, uint32_t height)
 
 int RenderEnableTexture(Texture texture)
 {
+    for(uint32_t i = 0; i < APP.renderer.activeTextureIDs.count; ++i) {
+        if(APP.renderer.activeTextureIDs.data[i] == texture.ID &&
+                APP.renderer.activeTextureIDs.samplers[i] == texture.samplerID) return (int)i;
+    }
+    if(APP.renderer.activeTextureIDs.count == MAXIMUM_BATCH_RENDERER_ACTIVE_TEXTURES) {
+        // Every unit is taken, draw the vertices sampling them and start over, textures no vertex uses are just dropped
+        renderFlushBatch();
+        APP.renderer.activeTextureIDs.count = 0;
+    }
     int index = APP.renderer.activeTextureIDs.count;
     APP.renderer.activeTextureIDs.data[index] = texture.ID;
+    APP.renderer.activeTextureIDs.samplers[index] = texture.samplerID;
     APP.renderer.activeTextureIDs.count += 1;
     return index;
 }
@@ -578,213 +1031,1023 @@ void RenderPutElement(int vertexIndex)
     APP.renderer.elements.count += 1;
 }
 
+void renderGetBatchRoom(uint32_t *vertexCount, uint32_t *elementCount)
+{
+    if(vertexCount) *vertexCount = MAXIMUM_BATCH_RENDERER_VERTICES - APP.renderer.vertices.count;
+    if(elementCount) *elementCount = MAXIMUM_BATCH_RENDERER_ELEMENTS - APP.renderer.elements.count;
+}
+
+_RenderVertex *renderReserveVertices(uint32_t vertexCount, uint32_t elementCount, uint32_t **elements, uint32_t *firstVertex)
+{
+    if(APP.renderer.vertices.count + vertexCount > MAXIMUM_BATCH_RENDERER_VERTICES) return NULL;
+    if(APP.renderer.elements.count + elementCount > MAXIMUM_BATCH_RENDERER_ELEMENTS) return NULL;
+
+    _RenderVertex *vertices = &APP.renderer.vertices.data[APP.renderer.vertices.count];
+    if(elements) *elements = &APP.renderer.elements.data[APP.renderer.elements.count];
+    if(firstVertex) *firstVertex = APP.renderer.vertices.count;
+    APP.renderer.vertices.count += vertexCount;
+    APP.renderer.elements.count += elementCount;
+    return vertices;
+}
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+static uint32_t compressedFormatToGL(int format)
+{
+    switch(format) {
+        case PIXEL_FORMAT_BC1_RGB: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case PIXEL_FORMAT_BC1_RGBA: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case PIXEL_FORMAT_BC3_RGBA: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case PIXEL_FORMAT_BC7_RGBA: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case PIXEL_FORMAT_ETC2_RGB: return GL_COMPRESSED_RGB8_ETC2;
+        case PIXEL_FORMAT_ETC2_RGBA: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case PIXEL_FORMAT_BC1_RGB_SRGB: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        case PIXEL_FORMAT_BC1_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case PIXEL_FORMAT_BC3_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        case PIXEL_FORMAT_BC7_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+        case PIXEL_FORMAT_ETC2_RGB_SRGB: return GL_COMPRESSED_SRGB8_ETC2;
+        case PIXEL_FORMAT_ETC2_RGBA_SRGB: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+        default: return 0;
+    }
+}
+
+static bool isPixelFormatCompressed(int format)
+{
+    return format >= PIXEL_FORMAT_BC1_RGB && format <= PIXEL_FORMAT_ETC2_RGBA_SRGB;
+}
+
+// Linear format with the same block layout as an sRGB one
+static int compressedLinearFormat(int format)
+{
+    if(format >= PIXEL_FORMAT_BC1_RGB_SRGB) return format - (PIXEL_FORMAT_BC1_RGB_SRGB - PIXEL_FORMAT_BC1_RGB);
+    return format;
+}
+
+static int pixelFormatFromComponents(uint32_t compAmount)
+{
+    switch(compAmount) {
+        case 1: return PIXEL_FORMAT_R8;
+        case 2: return PIXEL_FORMAT_RG8;
+        case 3: return PIXEL_FORMAT_RGB8;
+        default: return PIXEL_FORMAT_RGBA8;
+    }
+}
+
+size_t GetPixelDataSize(uint32_t width, uint32_t height, int format)
+{
+    size_t blocks = (size_t)((width + 3)/4)*((height + 3)/4);
+    switch(compressedLinearFormat(format)) {
+        case PIXEL_FORMAT_R8: return (size_t)width*height;
+        case PIXEL_FORMAT_RG8: return (size_t)width*height*2;
+        case PIXEL_FORMAT_RGB8: return (size_t)width*height*3;
+        case PIXEL_FORMAT_RGBA8: return (size_t)width*height*4;
+        case PIXEL_FORMAT_BC1_RGB:
+        case PIXEL_FORMAT_BC1_RGBA:
+        case PIXEL_FORMAT_ETC2_RGB: return blocks*8;
+        case PIXEL_FORMAT_BC3_RGBA:
+        case PIXEL_FORMAT_BC7_RGBA:
+        case PIXEL_FORMAT_ETC2_RGBA: return blocks*16;
+        default: return 0;
+    }
+}
+
+static bool hasExtensionGL(const char *name)
+{
+    int count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    size_t nameSize = StringLength(name);
+    for(int i = 0; i < count; ++i) {
+        const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if(extension && MemoryCompare(extension, name, nameSize) == 0) return true;
+    }
+    return false;
+}
+
+static bool isVersionGL(int major, int minor)
+{
+    int currentMajor = 0, currentMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &currentMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &currentMinor);
+    return currentMajor > major || (currentMajor == major && currentMinor >= minor);
+}
+
+bool renderHasSeparateShaders(void)
+{
+    return glCreateShaderProgramv && (isVersionGL(4, 1) || hasExtensionGL("GL_ARB_separate_shader_objects"));
+}
+
+bool IsPixelFormatSupported(int format)
+{
+    if(!isPixelFormatCompressed(format)) return format > PIXEL_FORMAT_INVALID && format <= PIXEL_FORMAT_RGBA8;
+
+    bool srgb = format != compressedLinearFormat(format);
+    switch(compressedLinearFormat(format)) {
+        case PIXEL_FORMAT_BC1_RGB:
+        case PIXEL_FORMAT_BC1_RGBA:
+        case PIXEL_FORMAT_BC3_RGBA: return hasExtensionGL("GL_EXT_texture_compression_s3tc") &&
+            (!srgb || hasExtensionGL("GL_EXT_texture_sRGB") || hasExtensionGL("GL_EXT_texture_compression_s3tc_srgb"));
+        case PIXEL_FORMAT_BC7_RGBA: return isVersionGL(4, 2) || hasExtensionGL("GL_ARB_texture_compression_bptc");
+        default: return isVersionGL(4, 3) || hasExtensionGL("GL_ARB_ES3_compatibility");
+    }
+}
+
+// GPU memory of a whole mip chain, RGB textures are stored as RGBA
+static size_t textureMemorySize(uint32_t width, uint32_t height, int format, uint32_t mipmaps)
+{
+    if(format == PIXEL_FORMAT_RGB8) format = PIXEL_FORMAT_RGBA8;
+    size_t result = 0;
+    for(uint32_t i = 0; i < mipmaps; ++i) {
+        result += GetPixelDataSize(width, height, format);
+        width = width > 1 ? width/2 : 1;
+        height = height > 1 ? height/2 : 1;
+    }
+    return result;
+}
+
+void renderSetTextureInfo(Texture *texture, uint32_t width, uint32_t height, uint32_t compAmount)
+{
+    uint32_t mipmaps = 1;
+    for(uint32_t size = width > height ? width : height; size > 1; size /= 2) mipmaps += 1;
+    texture->width = width;
+    texture->height = height;
+    texture->compAmount = compAmount;
+    texture->format = pixelFormatFromComponents(compAmount);
+    texture->mipmaps = mipmaps;
+    texture->memorySize = textureMemorySize(width, height, texture->format, mipmaps);
+}
+
+static uint32_t textureFormatFromComponents(uint32_t compAmount)
+{
+    switch(compAmount) {
+        case 1: return GL_RED;
+        case 2: return GL_RG;
+        case 3: return GL_RGB;
+        default: return GL_RGBA;
+    }
+}
+
+void renderTextureImage(int level, const void *data, uint32_t width, uint32_t height, uint32_t compAmount)
+{
+    switch(compAmount) {
+        case 1: {
+            // Grayscale, sampled as (r, r, r, 1)
+            int swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+            glTexImage2D(GL_TEXTURE_2D, level, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data);
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        } break;
+        case 2: {
+            // Grayscale + alpha, sampled as (r, r, r, g)
+            int swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, data);
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        } break;
+        default:
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, 
+                    compAmount== 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, data);
+            break;
+    }
+}
+
+uint32_t renderGenTexture(void)
+{
+    uint32_t result = 0;
+    glGenTextures(1, &result);
+    glBindTexture(GL_TEXTURE_2D, result);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return result;
+}
+
 bool LoadTexture(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount)
 {
     if(!texture) return false;
     if(!data) return false;
 
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture->ID = renderGenTexture();
+    glBindTexture(GL_TEXTURE_2D, texture->ID);
+    renderTextureImage(0, data, width, height, compAmount);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    renderSetTextureInfo(texture, width, height, compAmount);
+    texture->samplerID = 0;
+    TRACELOG(LOG_INFO, "Loaded texture with id %u", texture->ID);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+static uint32_t renderGetSampler(int filter, int wrap, bool mipmapped)
+{
+    if(filter < 0 || filter >= TEXTURE_FILTER_COUNT) filter = TEXTURE_FILTER_TRILINEAR;
+    if(wrap < 0 || wrap >= TEXTURE_WRAP_COUNT) wrap = TEXTURE_WRAP_REPEAT;
+    uint32_t *sampler = &APP.renderer.samplers[filter][wrap][mipmapped ? 1 : 0];
+    if(*sampler) return *sampler;
+
+    int minFilter, magFilter;
+    switch(filter) {
+        case TEXTURE_FILTER_NEAREST:
+            minFilter = mipmapped ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+            magFilter = GL_NEAREST;
+            break;
+        case TEXTURE_FILTER_BILINEAR:
+            minFilter = mipmapped ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR;
+            magFilter = GL_LINEAR;
+            break;
+        default:
+            minFilter = mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+            magFilter = GL_LINEAR;
+            break;
+    }
+    int wrapMode = wrap == TEXTURE_WRAP_CLAMP ? GL_CLAMP_TO_EDGE :
+        wrap == TEXTURE_WRAP_MIRRORED_REPEAT ? GL_MIRRORED_REPEAT : GL_REPEAT;
+
+    glGenSamplers(1, sampler);
+    glSamplerParameteri(*sampler, GL_TEXTURE_MIN_FILTER, minFilter);
+    glSamplerParameteri(*sampler, GL_TEXTURE_MAG_FILTER, magFilter);
+    glSamplerParameteri(*sampler, GL_TEXTURE_WRAP_S, wrapMode);
+    glSamplerParameteri(*sampler, GL_TEXTURE_WRAP_T, wrapMode);
+    return *sampler;
+}
+
+void SetTextureSampler(Texture *texture, int filter, int wrap)
+{
+    if(!texture) return;
+    texture->samplerID = renderGetSampler(filter, wrap, texture->mipmaps > 1);
+}
+
+// Multiply the color of RGBA8 and RG8 (gray and alpha) pixels by their alpha, other layouts have no alpha
+void renderPremultiplyAlpha(uint8_t *pixels, size_t pixelCount, uint32_t compAmount)
+{
+    if(compAmount != 2 && compAmount != 4) return;
+    uint32_t alphaOffset = compAmount - 1;
+    for(size_t i = 0; i < pixelCount; ++i) {
+        uint8_t *pixel = pixels + i*compAmount;
+        uint32_t alpha = pixel[alphaOffset];
+        if(alpha == 255) continue;
+        for(uint32_t c = 0; c < alphaOffset; ++c) pixel[c] = (uint8_t)((pixel[c]*alpha + 127)/255);
+    }
+}
+
+bool LoadTextureEx(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, TextureDesc desc)
+{
+    if(!texture) return false;
+    if(!data) return false;
+    if(desc.format == PIXEL_FORMAT_INVALID) desc.format = PIXEL_FORMAT_RGBA8;
+    if(desc.format > PIXEL_FORMAT_RGBA8) {
+        TRACELOG(LOG_ERROR, "`LoadTextureEx()` only takes uncompressed pixels, use `LoadTextureCompressed()`");
+        return false;
+    }
+
+    uint32_t compAmount = (uint32_t)desc.format; // R8 = 1, RG8 = 2, RGB8 = 3, RGBA8 = 4
+    uint32_t internalFormat, dataFormat = textureFormatFromComponents(compAmount);
+    switch(desc.format) {
+        case PIXEL_FORMAT_R8: internalFormat = GL_R8; break;
+        case PIXEL_FORMAT_RG8: internalFormat = GL_RG8; break;
+        case PIXEL_FORMAT_RGB8: internalFormat = desc.srgb ? GL_SRGB8 : GL_RGB8; break;
+        default: internalFormat = desc.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8; break;
+    }
+    if(desc.srgb && compAmount < 3) TRACELOG(LOG_WARNING, "sRGB storage is ignored for R8 and RG8 textures");
+
+    uint8_t *premultiplied = NULL;
+    if(desc.premultiplyAlpha && (compAmount == 2 || compAmount == 4)) {
+        size_t size = (size_t)width*height*compAmount;
+        premultiplied = MemoryAlloc(size);
+        if(!premultiplied) return false;
+        MemoryCopy(premultiplied, data, size);
+        renderPremultiplyAlpha(premultiplied, (size_t)width*height, compAmount);
+        data = premultiplied;
+    }
+
+    renderSetTextureInfo(texture, width, height, compAmount);
+    if(desc.mipmaps == TEXTURE_MIPMAPS_NONE) {
+        texture->mipmaps = 1;
+        texture->memorySize = GetPixelDataSize(width, height, desc.format == PIXEL_FORMAT_RGB8 ? PIXEL_FORMAT_RGBA8 : desc.format);
+    }
+
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glGenTextures(1, &texture->ID);
+    glBindTexture(GL_TEXTURE_2D, texture->ID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture->mipmaps - 1);
+    if(desc.immutable && glTexStorage2D) {
+        glTexStorage2D(GL_TEXTURE_2D, texture->mipmaps, internalFormat, width, height);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+    }
+    if(compAmount == 1) {
+        int swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    } else if(compAmount == 2) {
+        int swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_GREEN };
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    if(texture->mipmaps > 1) glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    MemoryFree(premultiplied);
+
+    SetTextureSampler(texture, desc.filter, desc.wrap);
+    TRACELOG(LOG_INFO, "Loaded texture with id %u (%u mipmaps, %zu bytes)", texture->ID, texture->mipmaps, texture->memorySize);
+    return true;
+}
+
+/**
+ * Load block compressed pixels, `data` holds `mipmaps` levels packed one after the other starting
+ * with the full size image. The levels are uploaded as they are, nothing is generated.
+ */
+bool renderUploadTextureCompressed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, int format, uint32_t mipmaps)
+{
+    if(!isPixelFormatCompressed(format)) return false;
+    if(!IsPixelFormatSupported(format)) {
+        TRACELOG(LOG_ERROR, "Compressed pixel format %d is not supported by the OpenGL driver", format);
+        return false;
+    }
+    if(mipmaps == 0) mipmaps = 1;
+
     glBindTexture(GL_TEXTURE_2D, texture->ID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, 
-            compAmount== 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipmaps - 1);
+
+    uint32_t glFormat = compressedFormatToGL(format);
+    uint32_t levelWidth = width, levelHeight = height;
+    size_t offset = 0;
+    for(uint32_t level = 0; level < mipmaps; ++level) {
+        size_t size = GetPixelDataSize(levelWidth, levelHeight, format);
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, glFormat, levelWidth, levelHeight, 0, size, data + offset);
+        offset += size;
+        levelWidth = levelWidth > 1 ? levelWidth/2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight/2 : 1;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    texture->height = height;
     texture->width = width;
-    texture->compAmount = compAmount;
-    TRACELOG(LOG_INFO, "Loaded texture with id %u", texture->ID);
+    texture->height = height;
+    int linearFormat = compressedLinearFormat(format);
+    texture->compAmount = (linearFormat == PIXEL_FORMAT_BC1_RGB || linearFormat == PIXEL_FORMAT_ETC2_RGB) ? 3 : 4;
+    texture->format = format;
+    texture->mipmaps = mipmaps;
+    texture->memorySize = offset;
+    texture->samplerID = 0;
+    return true;
+}
+
+bool LoadTextureCompressed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, int format, uint32_t mipmaps)
+{
+    if(!texture) return false;
+    if(!data) return false;
+
+    glGenTextures(1, &texture->ID);
+    if(!renderUploadTextureCompressed(texture, data, width, height, format, mipmaps)) {
+        glDeleteTextures(1, &texture->ID);
+        texture->ID = 0;
+        return false;
+    }
+    TRACELOG(LOG_INFO, "Loaded compressed texture with id %u (%u mipmaps, %zu bytes)", texture->ID, texture->mipmaps, texture->memorySize);
+    return true;
+}
+
+/**
+ * Map the next buffer of the upload ring, it is orphaned instead of waited on when the GPU still reads from it.
+ * Other uploads can happen before the buffer is submitted, so `bufferIndex` tells which one to submit.
+ */
+static void *renderMapUploadBuffer(size_t size, uint32_t *bufferIndex)
+{
+    uint32_t index = APP.renderer.upload.current;
+    // Skipped while a `BeginTextureUpdate()` still has it mapped
+    if(APP.renderer.upload.mapped.active && index == APP.renderer.upload.mapped.buffer)
+        index = (index + 1) % TEXTURE_UPLOAD_BUFFER_COUNT;
+    APP.renderer.upload.current = (index + 1) % TEXTURE_UPLOAD_BUFFER_COUNT;
+    *bufferIndex = index;
+    _RenderUploadBuffer *buffer = &APP.renderer.upload.buffers[index];
+    if(buffer->ID == 0) glGenBuffers(1, &buffer->ID);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->ID);
+
+    bool busy = false;
+    if(buffer->fence) {
+        busy = glClientWaitSync(buffer->fence, 0, 0) == GL_TIMEOUT_EXPIRED;
+        glDeleteSync(buffer->fence);
+        buffer->fence = NULL;
+    }
+    if(busy || size > buffer->capacity) {
+        if(size > buffer->capacity) buffer->capacity = size;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, buffer->capacity, NULL, GL_STREAM_DRAW);
+    }
+
+    void *result = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    // Left unbound so texture loads in between do not read from it
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return result;
+}
+
+// Unmap an upload buffer and copy it into the texture, `wholeImage` (re)allocates the texture storage
+static bool renderSubmitUploadBuffer(uint32_t bufferIndex, uint32_t textureID, int x, int y, uint32_t width, uint32_t height,
+        uint32_t compAmount, bool wholeImage)
+{
+    _RenderUploadBuffer *buffer = &APP.renderer.upload.buffers[bufferIndex];
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->ID);
+    if(!glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    if(wholeImage) renderTextureImage(0, (const void *)0, width, height, compAmount);
+    else glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height,
+            textureFormatFromComponents(compAmount), GL_UNSIGNED_BYTE, (const void *)0);
+    buffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+void *renderMapTextureImage(size_t size)
+{
+    return renderMapUploadBuffer(size, &APP.renderer.upload.imageBuffer);
+}
+
+void renderCancelTextureImage(void)
+{
+    _RenderUploadBuffer *buffer = &APP.renderer.upload.buffers[APP.renderer.upload.imageBuffer];
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->ID);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+bool renderSubmitTextureImage(uint32_t textureID, uint32_t width, uint32_t height, uint32_t compAmount)
+{
+    if(!renderSubmitUploadBuffer(APP.renderer.upload.imageBuffer, textureID, 0, 0, width, height, compAmount, true)) return false;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
     return true;
 }
 
+bool renderStreamTextureImage(uint32_t textureID, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount)
+{
+    if(!data) return false;
+    size_t size = (size_t)width*height*compAmount;
+    void *mapped = renderMapTextureImage(size);
+    if(!mapped) return false;
+    MemoryCopy(mapped, data, size);
+    return renderSubmitTextureImage(textureID, width, height, compAmount);
+}
+
+static bool isTextureRegionValid(Texture texture, int x, int y, uint32_t width, uint32_t height)
+{
+    if(x < 0 || y < 0 || width == 0 || height == 0) return false;
+    return (uint32_t)x + width <= texture.width && (uint32_t)y + height <= texture.height;
+}
+
+/**
+ * Replace the pixels of a texture, `pixels` has the same size and component amount as the texture.
+ * The copy goes through a ring of pixel buffers so the call does not wait on previous uploads.
+ * Mipmaps are not regenerated.
+ */
+bool UpdateTexture(Texture texture, const void *pixels)
+{
+    return UpdateTextureRegion(texture, 0, 0, texture.width, texture.height, pixels);
+}
+
+bool UpdateTextureRegion(Texture texture, int x, int y, uint32_t width, uint32_t height, const void *pixels)
+{
+    if(!pixels) return false;
+    void *mapped = BeginTextureUpdate(texture, x, y, width, height);
+    if(!mapped) return false;
+    MemoryCopy(mapped, pixels, (size_t)width*height*texture.compAmount);
+    return EndTextureUpdate();
+}
+
+/**
+ * Map memory for a tightly packed `width`x`height` region of the texture so pixels can be written in place,
+ * the region is transferred by `EndTextureUpdate()`. Only one update can be in progress.
+ */
+void *BeginTextureUpdate(Texture texture, int x, int y, uint32_t width, uint32_t height)
+{
+    if(APP.renderer.upload.mapped.active) {
+        TRACELOG(LOG_WARNING, "`BeginTextureUpdate()` called before ending the previous update");
+        return NULL;
+    }
+    if(isPixelFormatCompressed(texture.format)) {
+        TRACELOG(LOG_WARNING, "Compressed texture %u can not be updated", texture.ID);
+        return NULL;
+    }
+    if(!isTextureRegionValid(texture, x, y, width, height)) {
+        TRACELOG(LOG_WARNING, "Texture update region is outside of texture %u", texture.ID);
+        return NULL;
+    }
+
+    uint32_t bufferIndex = 0;
+    void *result = renderMapUploadBuffer((size_t)width*height*texture.compAmount, &bufferIndex);
+    if(!result) return NULL;
+    APP.renderer.upload.mapped.active = true;
+    APP.renderer.upload.mapped.buffer = bufferIndex;
+    APP.renderer.upload.mapped.textureID = texture.ID;
+    APP.renderer.upload.mapped.compAmount = texture.compAmount;
+    APP.renderer.upload.mapped.x = x;
+    APP.renderer.upload.mapped.y = y;
+    APP.renderer.upload.mapped.width = width;
+    APP.renderer.upload.mapped.height = height;
+    return result;
+}
+
+bool EndTextureUpdate(void)
+{
+    if(!APP.renderer.upload.mapped.active) return false;
+    APP.renderer.upload.mapped.active = false;
+    return renderSubmitUploadBuffer(APP.renderer.upload.mapped.buffer, APP.renderer.upload.mapped.textureID,
+            APP.renderer.upload.mapped.x, APP.renderer.upload.mapped.y,
+            APP.renderer.upload.mapped.width, APP.renderer.upload.mapped.height,
+            APP.renderer.upload.mapped.compAmount, false);
+}
+
 void UnloadTexture(Texture texture)
 {
+    if(cacheReleaseTexture(texture.ID)) return;
+    cancelAsyncTextureLoads(texture.ID);
+    residencyForgetTexture(texture.ID);
     glDeleteTextures(1, &texture.ID);
 }
 
-bool LoadShader(Shader *shader, const char *vertSource, const char *fragSource)
+static void attachProgramStages(uint32_t program, const char *vertSource, const char *fragSource,
+        uint32_t *vertModule, uint32_t *fragModule)
 {
-    if(!shader) return false;
-    if(!vertSource) return false;
-    if(!fragSource) return false;
-    uint32_t vertModule, fragModule;
-    int success;
+    *vertModule = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(*vertModule, 1, (const char **)&vertSource, NULL);
+    glCompileShader(*vertModule);
 
-    vertModule = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertModule, 1, (const char **)&vertSource, NULL);
-    glCompileShader(vertModule);
+    *fragModule = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(*fragModule, 1, (const char **)&fragSource, NULL);
+    glCompileShader(*fragModule);
+
+    glAttachShader(program, *vertModule);
+    glAttachShader(program, *fragModule);
+}
+
+// Submit both stages and the link without asking for their status, so the driver may compile in the background
+static uint32_t beginCompileProgram(const char *vertSource, const char *fragSource, uint32_t *vertModule, uint32_t *fragModule)
+{
+    uint32_t program = glCreateProgram();
+    attachProgramStages(program, vertSource, fragSource, vertModule, fragModule);
+    programCachePrepare(program);
+    glLinkProgram(program);
+    return program;
+}
+
+// Check the stages and the link of `beginCompileProgram()`, blocks until the driver is done
+static bool finishCompileProgram(uint32_t program, uint32_t vertModule, uint32_t fragModule)
+{
+    int success;
     glGetShaderiv(vertModule, GL_COMPILE_STATUS, &success);
     if(!success) {
         char info_log[512];
         glGetShaderInfoLog(vertModule, sizeof(info_log), NULL, info_log);
         TRACELOG(LOG_ERROR, "Vertex shader compilation error \"%s\"", info_log);
-        return false;
-    }
-
-    fragModule = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragModule, 1, (const char **)&fragSource, NULL);
-    glCompileShader(fragModule);
-    glGetShaderiv(fragModule, GL_COMPILE_STATUS, &success);
-    if(!success) {
-        char info_log[512];
-        glGetShaderInfoLog(fragModule, sizeof(info_log), NULL, info_log);
-        glDeleteShader(vertModule);
-        TRACELOG(LOG_ERROR, "Fragment shader compilation error \"%s\"", info_log);
-        return false;
+    } else {
+        glGetShaderiv(fragModule, GL_COMPILE_STATUS, &success);
+        if(!success) {
+            char info_log[512];
+            glGetShaderInfoLog(fragModule, sizeof(info_log), NULL, info_log);
+            TRACELOG(LOG_ERROR, "Fragment shader compilation error \"%s\"", info_log);
+        } else {
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if(!success) {
+                char info_log[512];
+                glGetProgramInfoLog(program, sizeof(info_log), NULL, info_log);
+                TRACELOG(LOG_ERROR, "Shader Linking Error: %s\n", info_log);
+            }
+        }
     }
 
-    shader->ID = glCreateProgram();
-    glAttachShader(shader->ID, vertModule);
-    glAttachShader(shader->ID, fragModule);
-    glLinkProgram(shader->ID);
-    glGetProgramiv(shader->ID, GL_LINK_STATUS, &success);
-    if(!success) {
-        char info_log[512];
-        glGetProgramInfoLog(shader->ID,  sizeof(info_log), NULL, info_log);
-        glDeleteShader(vertModule);
-        glDeleteShader(fragModule);
-        TRACELOG(LOG_ERROR, "Shader Linking Error: %s\n", info_log);
-        return false;
-    }
+    glDetachShader(program, vertModule);
+    glDetachShader(program, fragModule);
     glDeleteShader(vertModule);
     glDeleteShader(fragModule);
+    if(!success) glDeleteProgram(program);
+    return success != 0;
+}
 
-    glUseProgram(shader->ID);
+static bool compileProgram(uint32_t *programID, const char *vertSource, const char *fragSource)
+{
+    uint32_t vertModule, fragModule;
+    uint32_t program = beginCompileProgram(vertSource, fragSource, &vertModule, &fragModule);
+    if(!finishCompileProgram(program, vertModule, fragModule)) return false;
+    *programID = program;
+    return true;
+}
+
+bool renderFindShaderLocations(Shader shader, int *locs)
+{
     int loc = -1;
-    shader->locs = MemoryAlloc(sizeof(int) * MAXIMUM_SHADER_LOCS);
 
 #define GET_LOCATION_OF(func, name, mandatory) \
     do { \
-        loc = func(*shader, (name)); \
+        loc = func(shader, (name)); \
         if(loc < 0) { \
             TRACELOG((mandatory) ? LOG_ERROR : LOG_WARNING, "Failed to find location of %s", name); \
-            if(mandatory) { \
-                MemoryFree(shader->locs); \
-                return false; \
-            } \
+            if(mandatory) return false; \
         } \
     } while(0);
 
     GET_LOCATION_OF(GetShaderAttributeLocation, POSITION_SHADER_ATTRIBUTE_NAME, true);
-    shader->locs[POSITION_SHADER_ATTRIBUTE_LOCATION] = loc;
+    locs[POSITION_SHADER_ATTRIBUTE_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderAttributeLocation, COLOR_SHADER_ATTRIBUTE_NAME, true);
-    shader->locs[COLOR_SHADER_ATTRIBUTE_LOCATION] = loc;
+    locs[COLOR_SHADER_ATTRIBUTE_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderAttributeLocation, TEXCOORDS_SHADER_ATTRIBUTE_NAME, true);
-    shader->locs[TEXCOORDS_SHADER_ATTRIBUTE_LOCATION] = loc;
+    locs[TEXCOORDS_SHADER_ATTRIBUTE_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderAttributeLocation, TEXTURE_INDEX_SHADER_ATTRIBUTE_NAME, true);
-    shader->locs[TEXTURE_INDEX_SHADER_ATTRIBUTE_LOCATION] = loc;
+    locs[TEXTURE_INDEX_SHADER_ATTRIBUTE_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderUniformLocation, TEXTURE_SAMPLERS_SHADER_UNIFORM_NAME, true);
-    shader->locs[TEXTURE_SAMPLERS_SHADER_UNIFORM_LOCATION] = loc;
+    locs[TEXTURE_SAMPLERS_SHADER_UNIFORM_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderUniformLocation, PROJECTION_MATRIX_SHADER_UNIFORM_NAME, false);
-    shader->locs[PROJECTION_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
+    locs[PROJECTION_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderUniformLocation, VIEW_MATRIX_SHADER_UNIFORM_NAME, false);
-    shader->locs[VIEW_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
+    locs[VIEW_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
 
     GET_LOCATION_OF(GetShaderUniformLocation, MODEL_MATRIX_SHADER_UNIFORM_NAME, false);
-    shader->locs[MODEL_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
+    locs[MODEL_MATRIX_SHADER_UNIFORM_LOCATION] = loc;
 #undef GET_LOCATION_OF
 
-    glUseProgram(0);
     return true;
 }
 
-void UnloadShader(Shader shader)
+// Fill in the attribute and uniform locations the batch renderer uses
+static bool setupShaderLocations(Shader *shader)
 {
-    MemoryFree(shader.locs);
-    glDeleteProgram(shader.ID);
+    shader->variables = NULL;
+    shader->locs = MemoryAlloc(sizeof(int) * MAXIMUM_SHADER_LOCS);
+    if(!shader->locs) return false;
+    if(reflectShaderVariables(shader) && renderFindShaderLocations(*shader, shader->locs)) return true;
+    freeShaderVariables(*shader);
+    shader->variables = NULL;
+    MemoryFree(shader->locs);
+    shader->locs = NULL;
+    return false;
 }
 
-int GetShaderUniformLocation(Shader shader, const char *uniformName)
+bool LoadShader(Shader *shader, const char *vertSource, const char *fragSource)
 {
-    return glGetUniformLocation(shader.ID, uniformName);
+    if(!shader) return false;
+    if(!vertSource) return false;
+    if(!fragSource) return false;
+
+    if(!programCacheLoad(&shader->ID, vertSource, fragSource)) {
+        if(!compileProgram(&shader->ID, vertSource, fragSource)) return false;
+        programCacheStore(shader->ID, vertSource, fragSource);
+    }
+    return setupShaderLocations(shader);
 }
 
-int GetShaderAttributeLocation(Shader shader, const char *attributeName)
+static char *copyString(const char *string)
 {
-    return glGetAttribLocation(shader.ID, attributeName);
+    size_t size = StringLength(string);
+    char *result = MemoryAlloc(size);
+    if(result) MemoryCopy(result, string, size);
+    return result;
 }
 
-void SetProjectionMatrixUniform(Shader shader, float *matrixData)
+static void removePendingShader(uint32_t index)
 {
-    SetShaderUniform(shader, shader.locs[PROJECTION_MATRIX_SHADER_UNIFORM_LOCATION],
-            SHADER_UNIFORM_MAT4, (void *)matrixData, 1, false);
+    _PendingShader *pending = &APP.renderer.pendingShaders.data[index];
+    MemoryFree(pending->vertSource);
+    MemoryFree(pending->fragSource);
+    APP.renderer.pendingShaders.count -= 1;
+    *pending = APP.renderer.pendingShaders.data[APP.renderer.pendingShaders.count];
 }
 
-void SetViewMatrixUniform(Shader shader, float *matrixData)
+/**
+ * Start compiling a shader without waiting for the driver, `shader` is filled in by a later `BeginDrawing()`
+ * once the program is linked so it must stay valid until then. Submitting every shader before checking any
+ * lets drivers with GL_KHR_parallel_shader_compile build them on their own threads while the app keeps loading.
+ * `RenderFlush()` draws with the fallback shader (`SetFallbackShader()`) until `IsShaderReady()`,
+ * matrices set with `Set*MatrixUniform()` before then are applied once the program is linked.
+ */
+bool LoadShaderAsync(Shader *shader, const char *vertSource, const char *fragSource)
+{
+    if(!shader) return false;
+    if(!vertSource) return false;
+    if(!fragSource) return false;
+    shader->ID = 0;
+    shader->locs = NULL;
+    shader->variables = NULL;
+    if(programCacheLoad(&shader->ID, vertSource, fragSource)) return setupShaderLocations(shader);
+    if(APP.renderer.pendingShaders.count == MAXIMUM_PENDING_SHADERS) {
+        TRACELOG(LOG_WARNING, "Too many shaders compiling, compiling this one synchronously");
+        return LoadShader(shader, vertSource, fragSource);
+    }
+
+    if(!APP.renderer.pendingShaders.checkedParallel) {
+        APP.renderer.pendingShaders.checkedParallel = true;
+        if(hasExtensionGL("GL_KHR_parallel_shader_compile") || hasExtensionGL("GL_ARB_parallel_shader_compile")) {
+            _PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxShaderCompilerThreads =
+                (_PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)GetProcGL("glMaxShaderCompilerThreadsKHR");
+            if(!maxShaderCompilerThreads) maxShaderCompilerThreads =
+                (_PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)GetProcGL("glMaxShaderCompilerThreadsARB");
+            if(maxShaderCompilerThreads) maxShaderCompilerThreads(0xFFFFFFFF); // As many threads as the driver likes
+            APP.renderer.pendingShaders.parallel = true;
+        }
+    }
+
+    _PendingShader *pending = &APP.renderer.pendingShaders.data[APP.renderer.pendingShaders.count];
+    pending->vertSource = copyString(vertSource);
+    pending->fragSource = copyString(fragSource);
+    if(!pending->vertSource || !pending->fragSource) {
+        MemoryFree(pending->vertSource);
+        MemoryFree(pending->fragSource);
+        return false;
+    }
+    pending->shader = shader;
+    pending->setMatrices = 0;
+    pending->programID = beginCompileProgram(vertSource, fragSource, &pending->vertModule, &pending->fragModule);
+    shader->ID = pending->programID;
+    APP.renderer.pendingShaders.count += 1;
+    return true;
+}
+
+bool IsShaderReady(Shader shader)
 {
-    SetShaderUniform(shader, shader.locs[VIEW_MATRIX_SHADER_UNIFORM_LOCATION],
-            SHADER_UNIFORM_MAT4, (void *)matrixData, 1, false);
+    return shader.ID != 0 && shader.locs != NULL;
 }
 
-void SetModelMatrixUniform(Shader shader, float *matrixData)
+/**
+ * Shader `RenderFlush()` uses when it gets none or one still compiling, the built-in one unless set;
+ * an empty shader brings the built-in one back. The batch is dropped without any.
+ */
+void SetFallbackShader(Shader shader)
 {
-    SetShaderUniform(shader, shader.locs[MODEL_MATRIX_SHADER_UNIFORM_LOCATION],
-            SHADER_UNIFORM_MAT4, (void *)matrixData, 1, false);
+    APP.renderer.defaultShader = shader.ID != 0 ? shader : APP.renderer.builtinShader;
 }
 
-void SetShaderUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix)
+// Built-in shader with an orthographic projection of the window size in pixels, top left origin
+Shader GetDefaultShader(void)
 {
-    glUseProgram(shader.ID);
-    switch(uniformType) {
-        case SHADER_UNIFORM_FLOAT:
-            glUniform1fv(location, count, (const float *)data);
-            break;
-        case SHADER_UNIFORM_VEC2:
-            glUniform2fv(location, count, (const float *)data);
-            break;
-        case SHADER_UNIFORM_VEC3:
-            glUniform3fv(location, count, (const float *)data);
-            break;
-        case SHADER_UNIFORM_VEC4:
-            glUniform4fv(location, count, (const float *)data);
-            break;
-        case SHADER_UNIFORM_UINT:
-            glUniform1uiv(location, count, (const uint32_t *)data);
-            break;
-        case SHADER_UNIFORM_UVEC2:
-            glUniform2uiv(location, count, (const uint32_t *)data);
-            break;
-        case SHADER_UNIFORM_UVEC3:
-            glUniform3uiv(location, count, (const uint32_t *)data);
-            break;
-        case SHADER_UNIFORM_UVEC4:
-            glUniform4uiv(location, count, (const uint32_t *)data);
-            break;
-        case SHADER_UNIFORM_INT:
-            glUniform1iv(location, count, (const int *)data);
-            break;
-        case SHADER_UNIFORM_IVEC2:
-            glUniform2iv(location, count, (const int *)data);
-            break;
-        case SHADER_UNIFORM_IVEC3:
-            glUniform3iv(location, count, (const int *)data);
-            break;
-        case SHADER_UNIFORM_IVEC4:
-            glUniform4iv(location, count, (const int *)data);
-            break;
-        case SHADER_UNIFORM_MAT3:
-            glUniformMatrix3fv(location, count, transposeIfMatrix ? GL_TRUE : GL_FALSE, (const float *)data);
-            break;
-        case SHADER_UNIFORM_MAT4:
-            glUniformMatrix4fv(location, count, transposeIfMatrix ? GL_TRUE : GL_FALSE, (const float *)data);
-            break;
-        case SHADER_UNIFORM_SAMPLER:
-            glUniform1iv(location, count, data);
-            break;
-        default:
-            break;
+    return APP.renderer.builtinShader;
+}
+
+static const int MATRIX_UNIFORM_LOCATIONS[3] = {
+    PROJECTION_MATRIX_SHADER_UNIFORM_LOCATION,
+    VIEW_MATRIX_SHADER_UNIFORM_LOCATION,
+    MODEL_MATRIX_SHADER_UNIFORM_LOCATION,
+};
+
+static void applyPendingMatrices(_PendingShader *pending)
+{
+    Shader shader = *pending->shader;
+    for(uint32_t i = 0; i < 3; ++i) {
+        if(!(pending->setMatrices & (1u << i))) continue;
+        SetShaderUniform(shader, shader.locs[MATRIX_UNIFORM_LOCATIONS[i]], SHADER_UNIFORM_MAT4, pending->matrices[i], 1, false);
     }
+}
+
+// Finish the programs the driver is done with, every pending one when it can not tell
+void updateAsyncShaderCompiles(void)
+{
+    for(uint32_t i = 0; i < APP.renderer.pendingShaders.count;) {
+        _PendingShader *pending = &APP.renderer.pendingShaders.data[i];
+        if(APP.renderer.pendingShaders.parallel) {
+            int completed = 0;
+            glGetProgramiv(pending->programID, GL_COMPLETION_STATUS_KHR, &completed);
+            if(!completed) {
+                i += 1;
+                continue;
+            }
+        }
+
+        Shader *shader = pending->shader;
+        if(finishCompileProgram(pending->programID, pending->vertModule, pending->fragModule)) {
+            if(setupShaderLocations(shader)) {
+                applyPendingMatrices(pending);
+                programCacheStore(shader->ID, pending->vertSource, pending->fragSource);
+                TRACELOG(LOG_INFO, "Compiled shader with id %u", shader->ID);
+            } else {
+                glDeleteProgram(shader->ID);
+                shader->ID = 0;
+            }
+        } else {
+            shader->ID = 0;
+        }
+        removePendingShader(i);
+    }
+}
+
+/**
+ * Value of a plain uniform, kept across `renderReplaceShaderProgram()` since linking resets every uniform.
+ * Arrays and uniform block members are left out, the batch renderer sets its sampler array on each flush.
+ */
+typedef struct _PreservedUniform {
+    char name[64];
+    uint32_t type;
+    union {
+        float f[16];
+        int i[4];
+        uint32_t u[4];
+    } value;
+} _PreservedUniform;
+
+static uint32_t saveShaderUniforms(uint32_t program, _PreservedUniform *uniforms)
+{
+    int activeCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeCount);
+    uint32_t count = 0;
+    for(int i = 0; i < activeCount && count < MAXIMUM_PRESERVED_UNIFORMS; ++i) {
+        _PreservedUniform *uniform = &uniforms[count];
+        int size = 0;
+        glGetActiveUniform(program, (uint32_t)i, sizeof(uniform->name), NULL, &size, &uniform->type, uniform->name);
+        int loc = glGetUniformLocation(program, uniform->name);
+        if(size != 1 || loc < 0) continue;
+        switch(uniform->type) {
+            case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+            case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+                glGetUniformfv(program, loc, uniform->value.f);
+                break;
+            case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+            case GL_BOOL: case GL_SAMPLER_2D:
+                glGetUniformiv(program, loc, uniform->value.i);
+                break;
+            case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+                glGetUniformuiv(program, loc, uniform->value.u);
+                break;
+            default:
+                continue;
+        }
+        count += 1;
+    }
+    return count;
+}
+
+// Set the saved values on the uniforms the new program still has with the same name and type
+static void restoreShaderUniforms(uint32_t program, const _PreservedUniform *uniforms, uint32_t count)
+{
+    glUseProgram(program);
+    for(uint32_t i = 0; i < count; ++i) {
+        const _PreservedUniform *uniform = &uniforms[i];
+        int loc = glGetUniformLocation(program, uniform->name);
+        if(loc < 0) continue;
+        uint32_t index = 0, type = 0;
+        int size = 0;
+        const char *name = uniform->name;
+        char activeName[sizeof(uniform->name)];
+        glGetUniformIndices(program, 1, &name, &index);
+        if(index == GL_INVALID_INDEX) continue;
+        glGetActiveUniform(program, index, sizeof(activeName), NULL, &size, &type, activeName);
+        if(type != uniform->type || size != 1) continue;
+        switch(type) {
+            case GL_FLOAT: glUniform1fv(loc, 1, uniform->value.f); break;
+            case GL_FLOAT_VEC2: glUniform2fv(loc, 1, uniform->value.f); break;
+            case GL_FLOAT_VEC3: glUniform3fv(loc, 1, uniform->value.f); break;
+            case GL_FLOAT_VEC4: glUniform4fv(loc, 1, uniform->value.f); break;
+            case GL_FLOAT_MAT2: glUniformMatrix2fv(loc, 1, GL_FALSE, uniform->value.f); break;
+            case GL_FLOAT_MAT3: glUniformMatrix3fv(loc, 1, GL_FALSE, uniform->value.f); break;
+            case GL_FLOAT_MAT4: glUniformMatrix4fv(loc, 1, GL_FALSE, uniform->value.f); break;
+            case GL_INT: case GL_BOOL: case GL_SAMPLER_2D: glUniform1iv(loc, 1, uniform->value.i); break;
+            case GL_INT_VEC2: glUniform2iv(loc, 1, uniform->value.i); break;
+            case GL_INT_VEC3: glUniform3iv(loc, 1, uniform->value.i); break;
+            case GL_INT_VEC4: glUniform4iv(loc, 1, uniform->value.i); break;
+            case GL_UNSIGNED_INT: glUniform1uiv(loc, 1, uniform->value.u); break;
+            case GL_UNSIGNED_INT_VEC2: glUniform2uiv(loc, 1, uniform->value.u); break;
+            case GL_UNSIGNED_INT_VEC3: glUniform3uiv(loc, 1, uniform->value.u); break;
+            case GL_UNSIGNED_INT_VEC4: glUniform4uiv(loc, 1, uniform->value.u); break;
+        }
+    }
+    glUseProgram(0);
+}
+
+// Copy the linked binary of `source` into `program`, false when the driver can not
+static bool copyProgramBinary(uint32_t program, uint32_t source)
+{
+    if(!glGetProgramBinary || !glProgramBinary) return false;
+    int length = 0;
+    glGetProgramiv(source, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0) return false;
+    void *binary = MemoryAlloc((size_t)length);
+    if(!binary) return false;
+
+    int written = 0;
+    uint32_t binaryFormat = 0;
+    glGetProgramBinary(source, length, &written, &binaryFormat, binary);
+    int success = 0;
+    if(written > 0) {
+        glProgramBinary(program, binaryFormat, binary, written);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+    }
+    MemoryFree(binary);
+    return success != 0;
+}
+
+/**
+ * Give `shader` the program of `replacement` while keeping its ID and its locs array,
+ * so every copy of `shader` handed out draws with the new program. `replacement` must be ready
+ * and is left for the caller to unload; its sources relink `shader` when the binary can not be copied.
+ * Plain uniform values set on `shader` are carried over.
+ */
+bool renderReplaceShaderProgram(Shader *shader, Shader replacement, const char *vertSource, const char *fragSource)
+{
+    if(!IsShaderReady(*shader) || !IsShaderReady(replacement)) return false;
+    renderFlushBatch();
+
+    // Staged values have to be in the program to be carried over
+    glUseProgram(shader->ID);
+    uploadShaderUniforms(*shader);
     glUseProgram(0);
+    _PreservedUniform uniforms[MAXIMUM_PRESERVED_UNIFORMS];
+    uint32_t uniformCount = saveShaderUniforms(shader->ID, uniforms);
+
+    if(!copyProgramBinary(shader->ID, replacement.ID)) {
+        uint32_t vertModule, fragModule;
+        attachProgramStages(shader->ID, vertSource, fragSource, &vertModule, &fragModule);
+        glLinkProgram(shader->ID);
+        glDetachShader(shader->ID, vertModule);
+        glDetachShader(shader->ID, fragModule);
+        glDeleteShader(vertModule);
+        glDeleteShader(fragModule);
+        int success = 0;
+        glGetProgramiv(shader->ID, GL_LINK_STATUS, &success);
+        if(!success) {
+            TRACELOG(LOG_ERROR, "Failed to relink shader with id %u", shader->ID);
+            return false;
+        }
+    }
+
+    // Relinking may move attributes and uniforms around, the shadow copy picks up the restored values
+    restoreShaderUniforms(shader->ID, uniforms, uniformCount);
+    return reflectShaderVariables(shader) && renderFindShaderLocations(*shader, shader->locs);
+}
+
+void UnloadShader(Shader shader)
+{
+    if(pipelineReleaseShader(shader)) return;
+    if(cacheReleaseShader(shader.ID)) return;
+    hotReloadForgetShader(shader.ID);
+    for(uint32_t i = 0; i < APP.renderer.pendingShaders.count; ++i) {
+        _PendingShader *pending = &APP.renderer.pendingShaders.data[i];
+        if(pending->programID != shader.ID) continue;
+        glDeleteShader(pending->vertModule);
+        glDeleteShader(pending->fragModule);
+        removePendingShader(i);
+        break;
+    }
+    freeShaderVariables(shader);
+    MemoryFree(shader.locs);
+    glDeleteProgram(shader.ID);
+}
+
+// A shader from `LoadShaderAsync()` has no locations before it is linked, its matrices are set once it is
+static void setMatrixUniform(Shader shader, uint32_t matrix, float *matrixData)
+{
+    if(IsShaderReady(shader)) {
+        SetShaderUniform(shader, shader.locs[MATRIX_UNIFORM_LOCATIONS[matrix]], SHADER_UNIFORM_MAT4, matrixData, 1, false);
+        return;
+    }
+    for(uint32_t i = 0; shader.ID != 0 && i < APP.renderer.pendingShaders.count; ++i) {
+        _PendingShader *pending = &APP.renderer.pendingShaders.data[i];
+        if(pending->programID != shader.ID) continue;
+        MemoryCopy(pending->matrices[matrix], matrixData, sizeof(pending->matrices[matrix]));
+        pending->setMatrices |= 1u << matrix;
+        return;
+    }
+    TRACELOG(LOG_WARNING, "Shader with id %u is not loaded, matrix uniform is not set", shader.ID);
+}
+
+void SetProjectionMatrixUniform(Shader shader, float *matrixData)
+{
+    setMatrixUniform(shader, 0, matrixData);
+}
+
+void SetViewMatrixUniform(Shader shader, float *matrixData)
+{
+    setMatrixUniform(shader, 1, matrixData);
+}
+
+void SetModelMatrixUniform(Shader shader, float *matrixData)
+{
+    setMatrixUniform(shader, 2, matrixData);
 }
@@ -1,4 +1,5 @@
 #include "noe.h"
+#include "noe_internal.h"
 
 #define COLOR2VECTOR4(c) ((float)(c).r/255.0f),((float)(c).g/255.0f),((float)(c).b/255.0f),((float)(c).a/255.0f)
 
@@ -7,8 +8,28 @@ void ClearBackground(Color color)
     RenderClear(COLOR2VECTOR4(color));
 }
 
+void BeginDrawing(void)
+{
+    updateAsyncTextureLoads();
+    updateTextureResidency();
+    updateRenderTexturePool();
+    updateAsyncReadbacks();
+    updateShaderHotReload();
+    updateAsyncShaderCompiles();
+}
+
+void EndDrawing(void)
+{
+    SwapBufferGL();
+}
+
 void DrawTriangle(Color color, int x1, int y1, int x2, int y2, int x3, int y3)
 {
+    int minX = x1 < x2 ? (x1 < x3 ? x1 : x3) : (x2 < x3 ? x2 : x3);
+    int minY = y1 < y2 ? (y1 < y3 ? y1 : y3) : (y2 < y3 ? y2 : y3);
+    int maxX = x1 > x2 ? (x1 > x3 ? x1 : x3) : (x2 > x3 ? x2 : x3);
+    int maxY = y1 > y2 ? (y1 > y3 ? y1 : y3) : (y2 > y3 ? y2 : y3);
+    if(renderIsRectCulled((float)minX, (float)minY, (float)(maxX - minX), (float)(maxY - minY))) return;
     RenderPutElement(RenderPutVertex((float)x1, (float)y1, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f));
     RenderPutElement(RenderPutVertex((float)x2, (float)y2, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f));
     RenderPutElement(RenderPutVertex((float)x3, (float)y3, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f));
@@ -16,6 +37,7 @@ void DrawTriangle(Color color, int x1, int y1, int x2, int y2, int x3, int y3)
 
 void DrawRectangle(Color color, int x, int y, uint32_t w, uint32_t h)
 {
+    if(renderIsRectCulled((float)x, (float)y, (float)w, (float)h)) return;
     int v0 = RenderPutVertex((float)x,  (float)y, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f);
     int v1 = RenderPutVertex((float)x + (float)w,  (float)y, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f);
     int v2 = RenderPutVertex((float)x + (float)w,  (float)y + (float)h, 0.0f, COLOR2VECTOR4(color), 0.0f, 0.0f, -1.0f);
@@ -30,18 +52,20 @@ void DrawRectangle(Color color, int x, int y, uint32_t w, uint32_t h)
 
 void DrawTexture(Texture texture, int x, int y, uint32_t w, uint32_t h)
 {
+    if(renderIsRectCulled((float)x, (float)y, (float)w, (float)h)) return;
+    residencyTrackTexture(texture, (float)w, (float)h);
     int textureIndex = RenderEnableTexture(texture);
     int tl = RenderPutVertex((float)x, (float)y, 0.0f,  
-            0.0f, 0.0f, 0.0f, 0.0f, 
+            1.0f, 1.0f, 1.0f, 1.0f, 
             0.0f, 0.0f, textureIndex);
     int tr = RenderPutVertex((float)x + (float)w, (float)y, 0.0f,  
-            0.0f, 0.0f, 0.0f, 0.0f,
+            1.0f, 1.0f, 1.0f, 1.0f,
             1.0f, 0.0f, textureIndex);
     int br = RenderPutVertex((float)x + (float)w, (float)y + (float)h,  
-            0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
             1.0f, 1.0f, textureIndex);
     int bl = RenderPutVertex((float)x, (float)y + (float)h, 0.0f,
-            0.0f, 0.0f, 0.0f, 0.0f,
+            1.0f, 1.0f, 1.0f, 1.0f,
             0.0f, 1.0f, textureIndex);
     RenderPutElement(tl);
     RenderPutElement(tr);
@@ -53,21 +77,24 @@ void DrawTexture(Texture texture, int x, int y, uint32_t w, uint32_t h)
 
 void DrawTextureEx(Texture texture, Rectangle src, Rectangle dst)
 {
+    if(renderIsRectCulled((float)dst.x, (float)dst.y, (float)dst.width, (float)dst.height)) return;
+    if(src.width != 0 && src.height != 0)
+        residencyTrackTexture(texture, (float)dst.width*texture.width/src.width, (float)dst.height*texture.height/src.height);
     int textureIndex = RenderEnableTexture(texture);
     int tl = RenderPutVertex((float)dst.x, (float)dst.y, 0.0f,  
-            0.0f, 0.0f, 0.0f, 0.0f, 
+            1.0f, 1.0f, 1.0f, 1.0f, 
             ((float)src.x)/texture.width, ((float)src.y)/texture.height, 
             textureIndex);
     int tr = RenderPutVertex((float)dst.x + (float)dst.width, (float)dst.y, 0.0f,  
-            0.0f, 0.0f, 0.0f, 0.0f,
+            1.0f, 1.0f, 1.0f, 1.0f,
             ((float)src.x + (float)src.width)/texture.width, ((float)src.y)/texture.height, 
             textureIndex);
     int br = RenderPutVertex((float)dst.x + (float)dst.width, (float)dst.y + (float)dst.height,  
-            0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 1.0f, 1.0f, 1.0f,
             ((float)src.x + (float)src.width)/texture.width, ((float)src.y + (float)src.height)/texture.height, 
             textureIndex);
     int bl = RenderPutVertex((float)dst.x, (float)dst.y + (float)dst.height, 0.0f,
-            0.0f, 0.0f, 0.0f, 0.0f,
+            1.0f, 1.0f, 1.0f, 1.0f,
             ((float)src.x)/texture.width, ((float)src.y + (float)src.height)/texture.height, 
             textureIndex);
     RenderPutElement(tl);
@@ -77,3 +104,193 @@ void DrawTextureEx(Texture texture, Rectangle src, Rectangle dst)
     RenderPutElement(bl);
     RenderPutElement(tl);
 }
+
+void DrawText(Font font, Color color, const char *text, int x, int y, uint32_t fontSize)
+{
+    if(!text || font.baseSize == 0) return;
+    int textureIndex = RenderEnableTexture(font.texture) + SDF_TEXTURE_INDEX_OFFSET;
+    float scale = (float)fontSize/(float)font.baseSize;
+    float padding = (float)font.glyphPadding*scale;
+    float penX = (float)x;
+    float penY = (float)y;
+
+    for(const char *c = text; *c != '\0'; ++c) {
+        if(*c == '\n') {
+            penX = (float)x;
+            penY += (float)fontSize;
+            continue;
+        }
+
+        int glyphIndex = (int)(unsigned char)*c - font.firstCodepoint;
+        Rectangle src = glyphIndex >= 0 && glyphIndex < font.glyphCount ? font.glyphs[glyphIndex].rect : CLITERAL(Rectangle){0};
+        float x0 = penX - padding;
+        float y0 = penY - padding;
+        float x1 = x0 + (float)src.width*scale;
+        float y1 = y0 + (float)src.height*scale;
+        if(src.width > 0 && !renderIsRectCulled(x0, y0, x1 - x0, y1 - y0)) {
+            float u0 = (float)src.x/font.texture.width;
+            float v0 = (float)src.y/font.texture.height;
+            float u1 = ((float)src.x + (float)src.width)/font.texture.width;
+            float v1 = ((float)src.y + (float)src.height)/font.texture.height;
+
+            int tl = RenderPutVertex(x0, y0, 0.0f, COLOR2VECTOR4(color), u0, v0, textureIndex);
+            int tr = RenderPutVertex(x1, y0, 0.0f, COLOR2VECTOR4(color), u1, v0, textureIndex);
+            int br = RenderPutVertex(x1, y1, 0.0f, COLOR2VECTOR4(color), u1, v1, textureIndex);
+            int bl = RenderPutVertex(x0, y1, 0.0f, COLOR2VECTOR4(color), u0, v1, textureIndex);
+            RenderPutElement(tl);
+            RenderPutElement(tr);
+            RenderPutElement(br);
+            RenderPutElement(br);
+            RenderPutElement(bl);
+            RenderPutElement(tl);
+        }
+        penX += (float)font.glyphWidth*scale;
+    }
+}
+
+#ifndef MAXIMUM_NPATCH_TILES
+    #define MAXIMUM_NPATCH_TILES 64
+#endif
+
+typedef struct _NPatchSpan {
+    float pos0, pos1;
+    float tex0, tex1;
+} _NPatchSpan;
+
+// Split one axis of a nine-slice into spans, the middle part is either one stretched span or repeated tiles
+static int nPatchSpans(_NPatchSpan *spans, float dstPos, float dstSize, float srcPos, float srcSize,
+        float borderLow, float borderHigh, float texSize, bool tile)
+{
+    // Shrink the borders proportionally when the destination is smaller than both of them
+    float dstLow = borderLow, dstHigh = borderHigh;
+    if(dstLow + dstHigh > dstSize) {
+        float scale = dstSize/(dstLow + dstHigh);
+        dstLow *= scale;
+        dstHigh *= scale;
+    }
+    float middleSrc = srcSize - borderLow - borderHigh;
+    float middleDst = dstSize - dstLow - dstHigh;
+    int count = 0;
+
+    spans[count++] = CLITERAL(_NPatchSpan){ dstPos, dstPos + dstLow, srcPos/texSize, (srcPos + borderLow)/texSize };
+    if(!tile || middleSrc <= 0.0f) {
+        spans[count++] = CLITERAL(_NPatchSpan){ dstPos + dstLow, dstPos + dstLow + middleDst,
+            (srcPos + borderLow)/texSize, (srcPos + borderLow + middleSrc)/texSize };
+    } else {
+        float pos = dstPos + dstLow;
+        float end = pos + middleDst;
+        while(pos < end) {
+            float size = (end - pos) < middleSrc ? (end - pos) : middleSrc;
+            float srcSpan = size;
+            if(count == MAXIMUM_NPATCH_TILES && pos + size < end) {
+                // Out of tiles, the last one stretches the middle over what is left
+                size = end - pos;
+                srcSpan = middleSrc;
+            }
+            spans[count++] = CLITERAL(_NPatchSpan){ pos, pos + size,
+                (srcPos + borderLow)/texSize, (srcPos + borderLow + srcSpan)/texSize };
+            pos += size;
+        }
+    }
+    spans[count++] = CLITERAL(_NPatchSpan){ dstPos + dstSize - dstHigh, dstPos + dstSize,
+        (srcPos + srcSize - borderHigh)/texSize, (srcPos + srcSize)/texSize };
+    return count;
+}
+
+// Reserve the vertices of a nine-slice, a full batch is flushed and the texture enabled again in the new one
+static _RenderVertex *nPatchReserve(Texture texture, uint32_t vertexCount, uint32_t elementCount,
+        uint32_t **elements, uint32_t *base, int *textureIndex)
+{
+    _RenderVertex *vertices = renderReserveVertices(vertexCount, elementCount, elements, base);
+    if(!vertices) {
+        renderFlushBatch();
+        *textureIndex = RenderEnableTexture(texture);
+        vertices = renderReserveVertices(vertexCount, elementCount, elements, base);
+    }
+    if(!vertices) TRACELOG(LOG_WARNING, "Nine-slice needs more room than an empty batch has, skipping it");
+    return vertices;
+}
+
+void DrawTextureNPatch(Texture texture, NPatchInfo info, Rectangle dst)
+{
+    if(texture.width == 0 || texture.height == 0) return;
+    if(renderIsRectCulled((float)dst.x, (float)dst.y, (float)dst.width, (float)dst.height)) return;
+
+    bool tile = info.layout == NPATCH_TILE;
+    _NPatchSpan columns[MAXIMUM_NPATCH_TILES + 2];
+    _NPatchSpan rows[MAXIMUM_NPATCH_TILES + 2];
+    int columnCount = nPatchSpans(columns, (float)dst.x, (float)dst.width, (float)info.source.x, (float)info.source.width,
+            (float)info.left, (float)info.right, (float)texture.width, tile);
+    int rowCount = nPatchSpans(rows, (float)dst.y, (float)dst.height, (float)info.source.y, (float)info.source.height,
+            (float)info.top, (float)info.bottom, (float)texture.height, tile);
+
+    if(info.source.width != 0 && info.source.height != 0) {
+        residencyTrackTexture(texture, (float)dst.width*texture.width/info.source.width,
+                (float)dst.height*texture.height/info.source.height);
+    }
+    int textureIndex = RenderEnableTexture(texture);
+    uint32_t *elements = NULL;
+    uint32_t base = 0;
+
+    if(!tile) {
+        // 4x4 shared vertices, 9 quads
+        _RenderVertex *vertices = nPatchReserve(texture, 16, 54, &elements, &base, &textureIndex);
+        if(!vertices) return;
+        float xs[4] = { columns[0].pos0, columns[1].pos0, columns[2].pos0, columns[2].pos1 };
+        float us[4] = { columns[0].tex0, columns[1].tex0, columns[2].tex0, columns[2].tex1 };
+        float ys[4] = { rows[0].pos0, rows[1].pos0, rows[2].pos0, rows[2].pos1 };
+        float vs[4] = { rows[0].tex0, rows[1].tex0, rows[2].tex0, rows[2].tex1 };
+        for(int y = 0; y < 4; ++y) {
+            for(int x = 0; x < 4; ++x) {
+                _RenderVertex *v = &vertices[y*4 + x];
+                *v = CLITERAL(_RenderVertex){
+                    .pos = { xs[x], ys[y], 0.0f },
+                    .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+                    .texCoords = { us[x], vs[y] },
+                    .textureIndex = (float)textureIndex,
+                };
+            }
+        }
+        for(uint32_t y = 0; y < 3; ++y) {
+            for(uint32_t x = 0; x < 3; ++x) {
+                uint32_t tl = base + y*4 + x;
+                uint32_t *quad = &elements[(y*3 + x)*6];
+                quad[0] = tl;
+                quad[1] = tl + 1;
+                quad[2] = tl + 5;
+                quad[3] = tl + 5;
+                quad[4] = tl + 4;
+                quad[5] = tl;
+            }
+        }
+        return;
+    }
+
+    // Tiles do not share texture coordinates, so every one of them is its own quad
+    uint32_t quadCount = (uint32_t)(columnCount*rowCount);
+    _RenderVertex *vertices = nPatchReserve(texture, quadCount*4, quadCount*6, &elements, &base, &textureIndex);
+    if(!vertices) return;
+    for(int y = 0; y < rowCount; ++y) {
+        for(int x = 0; x < columnCount; ++x) {
+            uint32_t quad = (uint32_t)(y*columnCount + x);
+            _RenderVertex *v = &vertices[quad*4];
+            v[0] = CLITERAL(_RenderVertex){ .pos = { columns[x].pos0, rows[y].pos0, 0.0f }, .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+                .texCoords = { columns[x].tex0, rows[y].tex0 }, .textureIndex = (float)textureIndex };
+            v[1] = CLITERAL(_RenderVertex){ .pos = { columns[x].pos1, rows[y].pos0, 0.0f }, .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+                .texCoords = { columns[x].tex1, rows[y].tex0 }, .textureIndex = (float)textureIndex };
+            v[2] = CLITERAL(_RenderVertex){ .pos = { columns[x].pos1, rows[y].pos1, 0.0f }, .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+                .texCoords = { columns[x].tex1, rows[y].tex1 }, .textureIndex = (float)textureIndex };
+            v[3] = CLITERAL(_RenderVertex){ .pos = { columns[x].pos0, rows[y].pos1, 0.0f }, .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+                .texCoords = { columns[x].tex0, rows[y].tex1 }, .textureIndex = (float)textureIndex };
+
+            uint32_t *e = &elements[quad*6];
+            uint32_t tl = base + quad*4;
+            e[0] = tl;
+            e[1] = tl + 1;
+            e[2] = tl + 2;
+            e[3] = tl + 2;
+            e[4] = tl + 3;
+            e[5] = tl;
+        }
+    }
+}
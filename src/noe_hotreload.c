@@ -0,0 +1,177 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#ifndef MAXIMUM_WATCHED_SHADERS
+    #define MAXIMUM_WATCHED_SHADERS 32
+#endif
+#ifndef MAXIMUM_WATCHED_PATH
+    #define MAXIMUM_WATCHED_PATH 260
+#endif
+#ifndef SHADER_RELOAD_DELAY_MS
+    #define SHADER_RELOAD_DELAY_MS 100 // Quiet time after the last change, editors write a file in several steps
+#endif
+
+/**
+ * Shader loaded with `LoadShaderFromFile()` while hot reload was on. A change to either file compiles
+ * both into `staging` with `LoadShaderAsync()`, `shader` only takes the new program once it is linked.
+ */
+typedef struct _WatchedShader {
+    Shader shader; // Shares its locs array with every copy handed out
+    char vertPath[MAXIMUM_WATCHED_PATH];
+    char fragPath[MAXIMUM_WATCHED_PATH];
+    int vertWatch, fragWatch;
+    bool changed; // A change was not compiled yet
+    uint64_t changedAt; // Time of the last change
+    bool compiling;
+    Shader staging;
+    char *vertSource, *fragSource; // Sources of `staging`
+} _WatchedShader;
+
+static struct {
+    _WatchedShader shaders[MAXIMUM_WATCHED_SHADERS];
+    bool enabled;
+    uint32_t reloads, failures;
+} HOTRELOAD = {0};
+
+static const char *getFileName(const char *filePath)
+{
+    const char *result = filePath;
+    for(const char *p = filePath; *p; ++p) {
+        if(*p == '/' || *p == '\\') result = p + 1;
+    }
+    return result;
+}
+
+static bool isWatchedFile(const char *filePath, int pathWatch, int watch, const char *fileName)
+{
+    const char *name = getFileName(filePath);
+    size_t size = StringLength(name);
+    return pathWatch == watch && size == StringLength(fileName) && MemoryCompare(name, fileName, size) == 0;
+}
+
+static void finishReload(_WatchedShader *watched)
+{
+    if(watched->staging.ID != 0) UnloadShader(watched->staging);
+    watched->staging = CLITERAL(Shader){0};
+    MemoryFree(watched->vertSource);
+    MemoryFree(watched->fragSource);
+    watched->vertSource = NULL;
+    watched->fragSource = NULL;
+    watched->compiling = false;
+}
+
+static void startReload(_WatchedShader *watched)
+{
+    watched->changed = false;
+    watched->vertSource = LoadFileText(watched->vertPath);
+    watched->fragSource = LoadFileText(watched->fragPath);
+    if(!watched->vertSource || !watched->fragSource) {
+        TRACELOG(LOG_WARNING, "Failed to read shader \"%s\" \"%s\" for reloading", watched->vertPath, watched->fragPath);
+        finishReload(watched);
+        return;
+    }
+    // Without the parallel compile extension the link finishes in the next `BeginDrawing()`
+    watched->compiling = true;
+    if(!LoadShaderAsync(&watched->staging, watched->vertSource, watched->fragSource)) {
+        if(watched->staging.ID != 0) UnloadShader(watched->staging);
+        watched->staging.ID = 0;
+    }
+}
+
+/**
+ * Recompile shaders loaded with `LoadShaderFromFile()` from now on whenever one of their files changes.
+ * The new program replaces the old one in place, so every copy of the shader picks it up;
+ * when it does not compile the old program stays in use. Only implemented on Linux.
+ */
+void SetShaderHotReload(bool enabled)
+{
+    HOTRELOAD.enabled = enabled;
+}
+
+void hotReloadWatchShader(Shader shader, const char *vertSourceFilePath, const char *fragSourceFilePath)
+{
+    if(!HOTRELOAD.enabled) return;
+    size_t vertSize = StringLength(vertSourceFilePath);
+    size_t fragSize = StringLength(fragSourceFilePath);
+    if(vertSize > MAXIMUM_WATCHED_PATH || fragSize > MAXIMUM_WATCHED_PATH) return;
+
+    _WatchedShader *watched = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_WATCHED_SHADERS && !watched; ++i) {
+        if(HOTRELOAD.shaders[i].shader.ID == 0) watched = &HOTRELOAD.shaders[i];
+    }
+    if(!watched) {
+        TRACELOG(LOG_WARNING, "Too many shaders to watch (%d), \"%s\" is not hot reloaded", MAXIMUM_WATCHED_SHADERS, vertSourceFilePath);
+        return;
+    }
+
+    watched->vertWatch = platformWatchFile(vertSourceFilePath);
+    watched->fragWatch = platformWatchFile(fragSourceFilePath);
+    if(watched->vertWatch < 0 && watched->fragWatch < 0) return;
+    MemoryCopy(watched->vertPath, vertSourceFilePath, vertSize);
+    MemoryCopy(watched->fragPath, fragSourceFilePath, fragSize);
+    watched->shader = shader;
+}
+
+// Stop watching the files of a shader being deleted, a reload in progress is dropped
+void hotReloadForgetShader(uint32_t shaderID)
+{
+    if(shaderID == 0) return;
+    for(uint32_t i = 0; i < MAXIMUM_WATCHED_SHADERS; ++i) {
+        _WatchedShader *watched = &HOTRELOAD.shaders[i];
+        if(watched->shader.ID != shaderID) continue;
+        finishReload(watched);
+        MemorySet(watched, 0, sizeof(*watched));
+        return;
+    }
+}
+
+void updateShaderHotReload(void)
+{
+    int watch;
+    char fileName[MAXIMUM_WATCHED_PATH];
+    while(platformPollFileChange(&watch, fileName, sizeof(fileName))) {
+        for(uint32_t i = 0; i < MAXIMUM_WATCHED_SHADERS; ++i) {
+            _WatchedShader *watched = &HOTRELOAD.shaders[i];
+            if(watched->shader.ID == 0) continue;
+            if(isWatchedFile(watched->vertPath, watched->vertWatch, watch, fileName) ||
+                    isWatchedFile(watched->fragPath, watched->fragWatch, watch, fileName)) {
+                watched->changed = true;
+                watched->changedAt = GetTimeMilis();
+            }
+        }
+    }
+
+    uint64_t now = GetTimeMilis();
+    for(uint32_t i = 0; i < MAXIMUM_WATCHED_SHADERS; ++i) {
+        _WatchedShader *watched = &HOTRELOAD.shaders[i];
+        if(watched->shader.ID == 0) continue;
+        if(watched->compiling) {
+            if(watched->staging.ID == 0) {
+                TRACELOG(LOG_WARNING, "Shader \"%s\" \"%s\" failed to compile, keeping the previous program",
+                        watched->vertPath, watched->fragPath);
+                HOTRELOAD.failures += 1;
+                finishReload(watched);
+            } else if(IsShaderReady(watched->staging)) {
+                if(renderReplaceShaderProgram(&watched->shader, watched->staging, watched->vertSource, watched->fragSource)) {
+                    TRACELOG(LOG_INFO, "Reloaded shader with id %u from \"%s\" \"%s\"",
+                            watched->shader.ID, watched->vertPath, watched->fragPath);
+                    HOTRELOAD.reloads += 1;
+                } else {
+                    HOTRELOAD.failures += 1;
+                }
+                finishReload(watched);
+            }
+            continue;
+        }
+        if(watched->changed && now - watched->changedAt >= SHADER_RELOAD_DELAY_MS) startReload(watched);
+    }
+}
+
+void deinitShaderHotReload(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_WATCHED_SHADERS; ++i) finishReload(&HOTRELOAD.shaders[i]);
+    platformDeinitFileWatcher();
+    if(HOTRELOAD.reloads + HOTRELOAD.failures > 0)
+        TRACELOG(LOG_INFO, "Shader hot reload: %u reloaded, %u failed", HOTRELOAD.reloads, HOTRELOAD.failures);
+    MemorySet(&HOTRELOAD, 0, sizeof(HOTRELOAD));
+}
@@ -4,10 +4,31 @@
 #include "noe.h"
 
 
+#ifndef MAXIMUM_WORKER_THREADS
+    #define MAXIMUM_WORKER_THREADS 4
+#endif
+#ifndef MAXIMUM_WORKER_JOBS
+    #define MAXIMUM_WORKER_JOBS 256
+#endif
+#ifndef MAXIMUM_SHADER_LOCS
+    #define MAXIMUM_SHADER_LOCS 16
+#endif
+#ifndef MAXIMUM_SHADER_VARIABLE_NAME
+    #define MAXIMUM_SHADER_VARIABLE_NAME 64
+#endif
+
 /*******************************
  * Internal Types
  *******************************/
 
+typedef void (*_WorkerJobFunc)(void *userData);
+
+// How a cached texture was loaded, files loaded differently are separate cache entries
+typedef enum _TextureCacheFlags {
+    TEXTURE_CACHE_FLIPPED = BIT(0),
+    TEXTURE_CACHE_PREMULTIPLIED = BIT(1),
+} _TextureCacheFlags;
+
 /**
  * Internal Application Configuration 
  */
@@ -61,6 +82,165 @@ typedef struct _InputManager {
     } mouse;
 } _InputManager;
 
+/**
+ * Active uniform or attribute of a linked program, found by the hash of its name.
+ * Arrays are stored under their name without the `[0]` suffix.
+ */
+typedef struct _ShaderVariable {
+    uint32_t hash; // 0 for an empty slot
+    int location;
+    int fragLocation; // When both stages of a program pipeline declare the uniform, -1 otherwise
+    int type; // `NoeShaderUniformType`, INVALID_SHADER_UNIFORM for attributes and unsupported types
+    int size; // Array length, 1 for plain variables
+    char name[MAXIMUM_SHADER_VARIABLE_NAME];
+    // Uniform staging, see `stageShaderUniform()`
+    uint32_t offset; // Of the shadow values in `_ShaderVariables.values`
+    uint32_t firstElement; // Of the element locations in `_ShaderVariables.elementLocations`
+    int dirtyFirst, dirtyEnd; // Elements waiting for an upload
+    bool synced; // Every element of the shadow copy matches the program
+} _ShaderVariable;
+
+// Open addressing table, `capacity` is a power of two at least twice `count`
+typedef struct _ShaderVariableMap {
+    _ShaderVariable *slots;
+    uint32_t capacity, count;
+} _ShaderVariableMap;
+
+typedef struct _ShaderVariables {
+    _ShaderVariableMap uniforms;
+    _ShaderVariableMap attributes;
+    uint8_t *values; // Shadow copy of every uniform with a `NoeShaderUniformType`
+    int *elementLocations; // Location of every array element of every uniform, -1 for an inactive one
+    int *slotByLocation; // Uniform slot of each location, array elements included, -1 for none
+    int *elementByLocation; // Array element of each location with a slot
+    int locationCount;
+    uint32_t *dirtySlots;
+    uint32_t dirtyCount;
+    uint32_t vertProgram, fragProgram; // Stage programs of a program pipeline, 0 for a linked program
+} _ShaderVariables;
+
+/**
+ * Internal Batch Renderer
+ */
+typedef struct _RenderVertex {
+    struct { float x, y, z; } pos;
+    struct { float r, g, b, a; } color;
+    struct { float u, v; } texCoords;
+    float textureIndex;
+} _RenderVertex;
+
 _InputManager *getApplicationInputManager(void);
+// Called by the platform layer when the window is resized
+void setApplicationWindowSize(uint32_t width, uint32_t height);
+
+// Defined in noe_platform_xxx.c
+uint64_t platformGetTimeMicros(void);
+bool platformInitWorkers(uint32_t workerCount);
+void platformDeinitWorkers(void);
+bool platformSubmitJob(_WorkerJobFunc func, void *userData);
+void platformYieldThread(void); // Let another thread run on this core
+bool platformMakeDirectory(const char *directoryPath); // True when it exists afterwards
+int platformWatchFile(const char *filePath); // Watch handle, -1 on failure
+bool platformPollFileChange(int *watch, char *fileName, size_t fileNameSize);
+void platformDeinitFileWatcher(void);
+
+// Defined in noe_loader.c
+void updateAsyncTextureLoads(void);
+void cancelAsyncTextureLoads(uint32_t textureID);
+void deinitAsyncTextureLoads(void);
+
+// Defined in noe_cache.c, `Unload*()` skips deleting objects that are still referenced
+bool cacheAcquireTexture(Texture *texture, const char *filePath, uint32_t flags);
+void cacheInsertTexture(Texture texture, const char *filePath, uint32_t flags);
+bool cacheReleaseTexture(uint32_t textureID);
+bool cacheAcquireShader(Shader *shader, const char *vertSourceFilePath, const char *fragSourceFilePath);
+void cacheInsertShader(Shader shader, const char *vertSourceFilePath, const char *fragSourceFilePath);
+bool cacheReleaseShader(uint32_t shaderID);
+
+// Defined in noe_residency.c
+void updateTextureResidency(void);
+// Record the on-screen size a texture was drawn at, in units of its whole image
+void residencyTrackTexture(Texture texture, float screenWidth, float screenHeight);
+void residencyForgetTexture(uint32_t textureID);
+
+// Defined in noe_rendertexture.c
+void updateRenderTexturePool(void);
+void deinitRenderTexturePool(void);
+
+// Defined in noe_programcache.c, `LoadShader()` links from a cached binary when it can
+bool programCacheLoad(uint32_t *programID, const char *vertSource, const char *fragSource);
+void programCachePrepare(uint32_t programID);
+void programCacheStore(uint32_t programID, const char *vertSource, const char *fragSource);
+
+// Defined in noe_readback.c
+void updateAsyncReadbacks(void);
+void deinitReadbacks(void);
+
+// Defined in noe_uniforms.c
+// Fill in the variables of a linked program, the table of `shader` is refilled in place when it has one
+bool reflectShaderVariables(Shader *shader);
+bool reflectPipelineVariables(Shader *shader, uint32_t vertProgram, uint32_t fragProgram);
+void freeShaderVariables(Shader shader);
+// Looked up by hash, `name` also has to match unless it is NULL
+const _ShaderVariable *findShaderVariable(const _ShaderVariableMap *map, uint32_t hash, const char *name);
+uint32_t hashShaderVariableName(const char *name, size_t length);
+// Write a uniform into the shadow copy, false when the value has to be uploaded right away instead
+bool stageShaderUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix);
+// Upload the staged uniforms that changed, `shader` has to be the bound program
+void uploadShaderUniforms(Shader shader);
+// Upload a uniform that could not be staged to the bound `shader`
+void uploadShaderUniform(Shader shader, int location, int uniformType, const void *data, int count);
+
+// Defined in noe_shadervariants.c
+void deinitShaderVariants(void);
+
+// Defined in noe_pipelines.c
+// Make `shader` current, program pipelines are bound instead of a program
+void pipelineBindShader(Shader shader);
+void pipelineUnbindShader(Shader shader);
+// Release a shader made by `LoadShaderPipeline()`, false for any other shader
+bool pipelineReleaseShader(Shader shader);
+void deinitShaderPipelines(void);
+
+// Defined in noe_hotreload.c
+void hotReloadWatchShader(Shader shader, const char *vertSourceFilePath, const char *fragSourceFilePath);
+void hotReloadForgetShader(uint32_t shaderID);
+void updateShaderHotReload(void);
+void deinitShaderHotReload(void);
+
+void updateAsyncShaderCompiles(void);
+bool renderHasSeparateShaders(void); // GL_ARB_separate_shader_objects or OpenGL 4.1
+// Look up the attribute and uniform locations the batch renderer uses into `locs`
+bool renderFindShaderLocations(Shader shader, int *locs);
+bool renderReplaceShaderProgram(Shader *shader, Shader replacement, const char *vertSource, const char *fragSource);
+// Draw what is in the batch with the shader of the last `RenderFlush()`, used when the render target changes
+void renderFlushBatch(void);
+// Set the blend state of `BeginBlendMode()` for draws that bypass the batch
+void renderApplyCurrentBlendMode(void);
+// Size of the render texture the batch draws into, 0 returns to the window, flush the batch first
+void renderSetTargetSize(uint32_t width, uint32_t height);
+// True when the world space rectangle is outside of the current camera view
+bool renderIsRectCulled(float x, float y, float width, float height);
+void renderGetBatchRoom(uint32_t *vertexCount, uint32_t *elementCount);
+// Reserve space for `vertexCount` vertices and `elementCount` elements in the current batch,
+// returns NULL when the batch has to be flushed first
+_RenderVertex *renderReserveVertices(uint32_t vertexCount, uint32_t elementCount, uint32_t **elements, uint32_t *firstVertex);
+float renderGetViewScale(void);
+// Specify one level of the bound texture with a format matching `compAmount`, `data` may be a pixel unpack buffer offset
+void renderTextureImage(int level, const void *data, uint32_t width, uint32_t height, uint32_t compAmount);
+// Fill in the size, format, mipmap count and memory size of an uncompressed texture with a full mip chain
+void renderSetTextureInfo(Texture *texture, uint32_t width, uint32_t height, uint32_t compAmount);
+void renderPremultiplyAlpha(uint8_t *pixels, size_t pixelCount, uint32_t compAmount);
+// Texture object with the sampling parameters of `LoadTexture()` and no storage yet
+uint32_t renderGenTexture(void);
+// Map `size` bytes of staging memory for a whole image,
+// `renderSubmitTextureImage()` uploads it and rebuilds the mipmaps, `renderCancelTextureImage()` drops it
+void *renderMapTextureImage(size_t size);
+bool renderSubmitTextureImage(uint32_t textureID, uint32_t width, uint32_t height, uint32_t compAmount);
+void renderCancelTextureImage(void);
+// Upload a whole image into an existing texture through the pixel unpack staging buffer and rebuild its mipmaps
+bool renderStreamTextureImage(uint32_t textureID, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount);
+// Replace the storage of an existing texture with compressed blocks, `data` holds every mipmap level from the largest one
+bool renderUploadTextureCompressed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, int format, uint32_t mipmaps);
 
 #endif // NOE_INTERNAL_H_
@@ -0,0 +1,600 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "vendors/stb/stb_image.h"
+
+#define NOQOI_IMPLEMENTATION
+#include "noqoi.h"
+
+#ifndef MAXIMUM_ASYNC_TEXTURE_LOADS
+    #define MAXIMUM_ASYNC_TEXTURE_LOADS 64
+#endif
+#ifndef MAXIMUM_ASYNC_TEXTURE_PATH
+    #define MAXIMUM_ASYNC_TEXTURE_PATH 260
+#endif
+#ifndef MAXIMUM_CONTAINER_TEXTURE_SIZE
+    #define MAXIMUM_CONTAINER_TEXTURE_SIZE 65536 // Keeps the size of the mipmap chain of a DDS/KTX2 file from overflowing
+#endif
+#ifndef DEFAULT_TEXTURE_UPLOAD_BUDGET
+    #define DEFAULT_TEXTURE_UPLOAD_BUDGET 2000 // In microseconds
+#endif
+
+typedef enum _TextureLoadState {
+    TEXTURE_LOAD_FREE = 0,
+    TEXTURE_LOAD_DECODING,
+    TEXTURE_LOAD_DECODED,
+    TEXTURE_LOAD_FAILED,
+} _TextureLoadState;
+
+typedef struct _TextureLoadJob {
+    atomic_int state;
+    char filePath[MAXIMUM_ASYNC_TEXTURE_PATH];
+    bool flipVerticallyOnLoad;
+    bool premultiplyAlpha;
+    uint32_t cacheFlags;
+    Texture *texture;
+    uint32_t textureID;
+    bool cancelled; // Set by `UnloadTexture()`, `texture` may already be gone
+
+    // Written by the worker thread before the state becomes `TEXTURE_LOAD_DECODED`
+    uint8_t *pixels;
+    bool pixelsFromStb; // Otherwise allocated with `MemoryAlloc()`
+    int width, height, compAmount;
+    bool compressed; // `pixels` holds the mipmap levels of a DDS/KTX2 file
+    int format;
+    uint32_t mipmaps;
+} _TextureLoadJob;
+
+static struct {
+    _TextureLoadJob jobs[MAXIMUM_ASYNC_TEXTURE_LOADS];
+    uint32_t uploadBudget;
+    bool premultiplyAlpha;
+} LOADER = {
+    .uploadBudget = DEFAULT_TEXTURE_UPLOAD_BUDGET,
+};
+
+char *LoadFileText(const char *filePath)
+{
+    size_t dataSize = 0;
+    return (char *)LoadFileData(filePath, &dataSize);
+}
+
+// The result is always null terminated, free it with `MemoryFree()`
+uint8_t *LoadFileData(const char *filePath, size_t *dataSize)
+{
+    if(!filePath) return NULL;
+    FILE *f = fopen(filePath, "rb");
+    if(!f) return NULL;
+
+    fseek(f, 0L, SEEK_END);
+    long filesz = ftell(f);
+    fseek(f, 0L, SEEK_SET);
+    if(filesz < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    uint8_t *result = MemoryAlloc((size_t)filesz + 1);
+    if(!result) {
+        fclose(f);
+        return NULL;
+    }
+    size_t readLength = fread(result, 1, (size_t)filesz, f);
+    result[readLength] = '\0';
+    fclose(f);
+    if(dataSize) *dataSize = readLength;
+    return result;
+}
+
+bool SaveFileData(const char *filePath, const void *data, size_t dataSize)
+{
+    if(!filePath) return false;
+    FILE *f = fopen(filePath, "wb");
+    if(!f) return false;
+    size_t written = fwrite(data, 1, dataSize, f);
+    fclose(f);
+    return written == dataSize;
+}
+
+/**
+ * Block compressed image read out of a DDS or KTX2 container,
+ * `levels` holds every mipmap level packed from the largest to the smallest one
+ */
+typedef struct _CompressedImage {
+    uint32_t width, height;
+    int format;
+    uint32_t mipmaps;
+    const uint8_t *levels;
+    uint8_t *ownedLevels; // Set when the levels had to be reordered
+} _CompressedImage;
+
+static const uint8_t DDS_SIGNATURE[4] = { 'D', 'D', 'S', ' ' };
+static const uint8_t KTX2_SIGNATURE[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+static uint32_t readU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t readU64(const uint8_t *p)
+{
+    return (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+}
+
+static size_t compressedChainSize(uint32_t width, uint32_t height, int format, uint32_t mipmaps)
+{
+    size_t result = 0;
+    for(uint32_t i = 0; i < mipmaps; ++i) {
+        result += GetPixelDataSize(width, height, format);
+        width = width > 1 ? width/2 : 1;
+        height = height > 1 ? height/2 : 1;
+    }
+    return result;
+}
+
+// Reject sizes no texture can have and clamp the mipmaps to the full chain, call before sizing the levels
+static bool checkCompressedImageSize(_CompressedImage *image)
+{
+    if(image->width == 0 || image->height == 0 ||
+            image->width > MAXIMUM_CONTAINER_TEXTURE_SIZE || image->height > MAXIMUM_CONTAINER_TEXTURE_SIZE) {
+        TRACELOG(LOG_ERROR, "Compressed texture has an invalid size %ux%u", image->width, image->height);
+        return false;
+    }
+    uint32_t maximumMipmaps = 1;
+    for(uint32_t size = image->width > image->height ? image->width : image->height; size > 1; size /= 2) maximumMipmaps += 1;
+    if(image->mipmaps == 0) image->mipmaps = 1;
+    if(image->mipmaps > maximumMipmaps) image->mipmaps = maximumMipmaps;
+    return true;
+}
+
+static int ddsFormatFromHeader(const uint8_t *pixelFormat, const uint8_t *dx10Header)
+{
+    const uint8_t *fourCC = pixelFormat + 8;
+    uint32_t flags = readU32(pixelFormat + 4);
+    if(MemoryCompare(fourCC, "DXT1", 4) == 0) return (flags & 0x1) ? PIXEL_FORMAT_BC1_RGBA : PIXEL_FORMAT_BC1_RGB; // DDPF_ALPHAPIXELS
+    if(MemoryCompare(fourCC, "DXT5", 4) == 0) return PIXEL_FORMAT_BC3_RGBA;
+    if(MemoryCompare(fourCC, "DX10", 4) == 0 && dx10Header) {
+        switch(readU32(dx10Header)) {
+            case 71: return PIXEL_FORMAT_BC1_RGBA; // DXGI_FORMAT_BC1_UNORM
+            case 72: return PIXEL_FORMAT_BC1_RGBA_SRGB; // DXGI_FORMAT_BC1_UNORM_SRGB
+            case 77: return PIXEL_FORMAT_BC3_RGBA; // DXGI_FORMAT_BC3_UNORM
+            case 78: return PIXEL_FORMAT_BC3_RGBA_SRGB; // DXGI_FORMAT_BC3_UNORM_SRGB
+            case 98: return PIXEL_FORMAT_BC7_RGBA; // DXGI_FORMAT_BC7_UNORM
+            case 99: return PIXEL_FORMAT_BC7_RGBA_SRGB; // DXGI_FORMAT_BC7_UNORM_SRGB
+        }
+    }
+    return PIXEL_FORMAT_INVALID;
+}
+
+static bool parseDDS(const uint8_t *data, size_t size, _CompressedImage *image)
+{
+    // Signature, 124 bytes header and an optional 20 bytes DX10 header
+    if(size < 128 || readU32(data + 4) != 124) return false;
+    const uint8_t *header = data + 4;
+    const uint8_t *pixelFormat = header + 72;
+    size_t dataOffset = 128;
+    const uint8_t *dx10Header = NULL;
+    if(MemoryCompare(pixelFormat + 8, "DX10", 4) == 0) {
+        if(size < 148) return false;
+        dx10Header = data + 128;
+        dataOffset = 148;
+    }
+
+    image->height = readU32(header + 8);
+    image->width = readU32(header + 12);
+    image->mipmaps = readU32(header + 24);
+    image->format = ddsFormatFromHeader(pixelFormat, dx10Header);
+    if(image->format == PIXEL_FORMAT_INVALID) {
+        TRACELOG(LOG_ERROR, "DDS pixel format is not supported");
+        return false;
+    }
+    if(!checkCompressedImageSize(image)) return false;
+    if(dataOffset + compressedChainSize(image->width, image->height, image->format, image->mipmaps) > size) return false;
+    image->levels = data + dataOffset;
+    image->ownedLevels = NULL;
+    return true;
+}
+
+static int ktx2FormatFromVkFormat(uint32_t vkFormat)
+{
+    switch(vkFormat) {
+        case 131: return PIXEL_FORMAT_BC1_RGB; // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132: return PIXEL_FORMAT_BC1_RGB_SRGB; // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 133: return PIXEL_FORMAT_BC1_RGBA; // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134: return PIXEL_FORMAT_BC1_RGBA_SRGB; // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 137: return PIXEL_FORMAT_BC3_RGBA; // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: return PIXEL_FORMAT_BC3_RGBA_SRGB; // VK_FORMAT_BC3_SRGB_BLOCK
+        case 145: return PIXEL_FORMAT_BC7_RGBA; // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146: return PIXEL_FORMAT_BC7_RGBA_SRGB; // VK_FORMAT_BC7_SRGB_BLOCK
+        case 147: return PIXEL_FORMAT_ETC2_RGB; // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148: return PIXEL_FORMAT_ETC2_RGB_SRGB; // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+        case 151: return PIXEL_FORMAT_ETC2_RGBA; // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        case 152: return PIXEL_FORMAT_ETC2_RGBA_SRGB; // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+        default: return PIXEL_FORMAT_INVALID;
+    }
+}
+
+static bool parseKTX2(const uint8_t *data, size_t size, _CompressedImage *image)
+{
+    // Identifier, 9 header fields, 4 index fields, 2 supercompression index fields
+    const size_t levelIndexOffset = 12 + 9*4 + 4*4 + 2*8;
+    if(size < levelIndexOffset) return false;
+    const uint8_t *header = data + 12;
+    image->format = ktx2FormatFromVkFormat(readU32(header));
+    image->width = readU32(header + 8);
+    image->height = readU32(header + 12);
+    uint32_t pixelDepth = readU32(header + 16);
+    uint32_t layerCount = readU32(header + 20);
+    uint32_t faceCount = readU32(header + 24);
+    image->mipmaps = readU32(header + 28);
+    uint32_t supercompression = readU32(header + 32);
+
+    if(image->format == PIXEL_FORMAT_INVALID) {
+        TRACELOG(LOG_ERROR, "KTX2 pixel format is not supported");
+        return false;
+    }
+    if(supercompression != 0 || pixelDepth > 1 || layerCount > 1 || faceCount != 1) {
+        TRACELOG(LOG_ERROR, "Only plain 2D KTX2 textures are supported");
+        return false;
+    }
+    if(!checkCompressedImageSize(image)) return false;
+    if(levelIndexOffset + (size_t)image->mipmaps*24 > size) return false;
+
+    // KTX2 stores the smallest level first
+    size_t chainSize = compressedChainSize(image->width, image->height, image->format, image->mipmaps);
+    image->ownedLevels = MemoryAlloc(chainSize);
+    if(!image->ownedLevels) return false;
+    uint32_t width = image->width, height = image->height;
+    size_t offset = 0;
+    for(uint32_t level = 0; level < image->mipmaps; ++level) {
+        const uint8_t *entry = data + levelIndexOffset + level*24;
+        uint64_t byteOffset = readU64(entry);
+        uint64_t byteLength = readU64(entry + 8);
+        size_t expected = GetPixelDataSize(width, height, image->format);
+        if(byteLength != expected || byteOffset > size || byteLength > size - byteOffset) {
+            MemoryFree(image->ownedLevels);
+            return false;
+        }
+        MemoryCopy(image->ownedLevels + offset, data + byteOffset, expected);
+        offset += expected;
+        width = width > 1 ? width/2 : 1;
+        height = height > 1 ? height/2 : 1;
+    }
+    image->levels = image->ownedLevels;
+    return true;
+}
+
+// Parse a DDS or KTX2 file, returns false without logging when `data` is in neither container
+static bool parseContainer(const uint8_t *data, size_t size, _CompressedImage *image, bool *isContainer)
+{
+    *isContainer = true;
+    if(size >= sizeof(DDS_SIGNATURE) && MemoryCompare(data, DDS_SIGNATURE, sizeof(DDS_SIGNATURE)) == 0) {
+        return parseDDS(data, size, image);
+    }
+    if(size >= sizeof(KTX2_SIGNATURE) && MemoryCompare(data, KTX2_SIGNATURE, sizeof(KTX2_SIGNATURE)) == 0) {
+        return parseKTX2(data, size, image);
+    }
+    *isContainer = false;
+    return false;
+}
+
+static bool loadTextureFromContainer(Texture *texture, const uint8_t *data, size_t size, bool *isContainer)
+{
+    _CompressedImage image;
+    if(!parseContainer(data, size, &image, isContainer)) return false;
+
+    bool result = LoadTextureCompressed(texture, image.levels, image.width, image.height, image.format, image.mipmaps);
+    MemoryFree(image.ownedLevels);
+    return result;
+}
+
+static uint32_t textureCacheFlags(bool flipVerticallyOnLoad)
+{
+    return (flipVerticallyOnLoad ? TEXTURE_CACHE_FLIPPED : 0) | (LOADER.premultiplyAlpha ? TEXTURE_CACHE_PREMULTIPLIED : 0);
+}
+
+// Decode a QOI image straight into the texture upload staging buffer, skipping the system memory copy
+static bool loadTextureFromQOI(Texture *texture, const char *filePath, const uint8_t *data, size_t size, bool flipVerticallyOnLoad)
+{
+    QoiDesc desc;
+    if(!QoiReadHeader(data, size, &desc)) return false;
+    size_t pixelsSize = (size_t)desc.width*desc.height*desc.channels;
+    if(LOADER.premultiplyAlpha && desc.channels == 4) {
+        // Premultiplying reads the pixels back, which is slow from mapped upload memory
+        uint8_t *pixels = MemoryAlloc(pixelsSize);
+        if(!pixels) return false;
+        bool result = QoiDecode(data, size, pixels, pixelsSize, flipVerticallyOnLoad);
+        if(result) {
+            renderPremultiplyAlpha(pixels, (size_t)desc.width*desc.height, desc.channels);
+            result = LoadTexture(texture, pixels, desc.width, desc.height, desc.channels);
+        }
+        MemoryFree(pixels);
+        return result;
+    }
+
+    uint32_t textureID = renderGenTexture();
+    void *pixels = renderMapTextureImage(pixelsSize);
+    if(!pixels) {
+        glDeleteTextures(1, &textureID);
+        return false;
+    }
+    if(!QoiDecode(data, size, pixels, pixelsSize, flipVerticallyOnLoad)) {
+        renderCancelTextureImage();
+        glDeleteTextures(1, &textureID);
+        return false;
+    }
+    if(!renderSubmitTextureImage(textureID, desc.width, desc.height, desc.channels)) {
+        glDeleteTextures(1, &textureID);
+        return false;
+    }
+
+    texture->ID = textureID;
+    renderSetTextureInfo(texture, desc.width, desc.height, desc.channels);
+    texture->samplerID = 0;
+    TRACELOG(LOG_INFO, "Loaded QOI texture \"%s\" with id %u", filePath, texture->ID);
+    return true;
+}
+
+/**
+ * Load a PNG, JPG, BMP, TGA, ... through stb_image, a QOI image through noqoi
+ * or a DDS/KTX2 file holding BC1/BC3/BC7/ETC2 blocks.
+ * Compressed files keep their own mipmaps and are never flipped.
+ */
+bool LoadTextureFromFile(Texture *texture, const char *filePath, bool flipVerticallyOnLoad)
+{
+    if(!texture) return false;
+    if(!filePath) return false;
+    uint32_t cacheFlags = textureCacheFlags(flipVerticallyOnLoad);
+    if(cacheAcquireTexture(texture, filePath, cacheFlags)) return true;
+
+    size_t fileSize = 0;
+    uint8_t *fileData = LoadFileData(filePath, &fileSize);
+    if(!fileData) return false;
+
+    bool result = false;
+    if(QoiIsImage(fileData, fileSize)) {
+        result = loadTextureFromQOI(texture, filePath, fileData, fileSize, flipVerticallyOnLoad);
+        if(!result) TRACELOG(LOG_ERROR, "Failed to decode QOI image \"%s\"", filePath);
+    } else {
+        bool isContainer = false;
+        result = loadTextureFromContainer(texture, fileData, fileSize, &isContainer);
+        if(!isContainer) {
+            int width, height, compAmount;
+            stbi_set_flip_vertically_on_load_thread(flipVerticallyOnLoad);
+            stbi_uc *data = stbi_load_from_memory(fileData, (int)fileSize, &width, &height, &compAmount, 0);
+            stbi_set_flip_vertically_on_load_thread(false);
+            if(data) {
+                if(LOADER.premultiplyAlpha) renderPremultiplyAlpha(data, (size_t)width*height, compAmount);
+                result = LoadTexture(texture, data, width, height, compAmount);
+                stbi_image_free(data);
+            }
+        } else if(!result) {
+            TRACELOG(LOG_ERROR, "Failed to load compressed texture \"%s\"", filePath);
+        }
+    }
+    MemoryFree(fileData);
+    if(result) cacheInsertTexture(*texture, filePath, cacheFlags);
+    return result;
+}
+
+bool LoadShaderFromFile(Shader *shader, const char *vertSourceFilePath, const char *fragSourceFilePath)
+{
+    if(!shader) return false;
+    if(cacheAcquireShader(shader, vertSourceFilePath, fragSourceFilePath)) return true;
+
+    char *vertSource = LoadFileText(vertSourceFilePath);
+    char *fragSource = LoadFileText(fragSourceFilePath);
+    bool result = LoadShader(shader, vertSource, fragSource);
+    MemoryFree(vertSource);
+    MemoryFree(fragSource);
+    if(result) {
+        cacheInsertShader(*shader, vertSourceFilePath, fragSourceFilePath);
+        hotReloadWatchShader(*shader, vertSourceFilePath, fragSourceFilePath);
+    }
+    return result;
+}
+
+// Runs on a worker thread, only touches the job itself
+static void decodeTextureJob(void *userData)
+{
+    _TextureLoadJob *job = userData;
+    size_t fileSize = 0;
+    uint8_t *fileData = LoadFileData(job->filePath, &fileSize);
+    if(fileData && QoiIsImage(fileData, fileSize)) {
+        // No GL context on the worker, so QOI decodes into system memory here
+        QoiDesc desc;
+        if(QoiReadHeader(fileData, fileSize, &desc)) {
+            size_t pixelsSize = (size_t)desc.width*desc.height*desc.channels;
+            job->pixels = MemoryAlloc(pixelsSize);
+            if(job->pixels && !QoiDecode(fileData, fileSize, job->pixels, pixelsSize, job->flipVerticallyOnLoad)) {
+                MemoryFree(job->pixels);
+                job->pixels = NULL;
+            }
+            job->width = desc.width;
+            job->height = desc.height;
+            job->compAmount = desc.channels;
+            job->pixelsFromStb = false;
+        }
+    } else if(fileData) {
+        _CompressedImage image;
+        bool isContainer = false;
+        if(parseContainer(fileData, fileSize, &image, &isContainer)) {
+            // The levels may point into the file data, which is freed below
+            job->pixels = image.ownedLevels;
+            if(!job->pixels) {
+                size_t chainSize = compressedChainSize(image.width, image.height, image.format, image.mipmaps);
+                job->pixels = MemoryAlloc(chainSize);
+                if(job->pixels) MemoryCopy(job->pixels, image.levels, chainSize);
+            }
+            job->width = (int)image.width;
+            job->height = (int)image.height;
+            job->format = image.format;
+            job->mipmaps = image.mipmaps;
+            job->compressed = true;
+            job->pixelsFromStb = false;
+        } else if(!isContainer) {
+            stbi_set_flip_vertically_on_load_thread(job->flipVerticallyOnLoad);
+            job->pixels = stbi_load_from_memory(fileData, (int)fileSize, &job->width, &job->height, &job->compAmount, 0);
+            job->pixelsFromStb = true;
+        }
+    }
+    MemoryFree(fileData);
+    if(job->pixels && job->premultiplyAlpha && !job->compressed) {
+        renderPremultiplyAlpha(job->pixels, (size_t)job->width*job->height, job->compAmount);
+    }
+    atomic_store_explicit(&job->state, job->pixels ? TEXTURE_LOAD_DECODED : TEXTURE_LOAD_FAILED, memory_order_release);
+}
+
+/**
+ * Start loading any file `LoadTextureFromFile()` accepts on a worker thread. `texture` gets a 1x1 white placeholder right away
+ * and is filled in by `BeginDrawing()` once the image is decoded and uploaded,
+ * so it must stay valid until `IsTextureReady()` returns true or the texture is unloaded.
+ * When the file fails to load the placeholder is deleted and `texture->ID` becomes 0.
+ */
+bool LoadTextureAsync(Texture *texture, const char *filePath, bool flipVerticallyOnLoad)
+{
+    if(!texture) return false;
+    if(!filePath) return false;
+    size_t pathSize = StringLength(filePath); // Includes the null terminator
+    if(pathSize > MAXIMUM_ASYNC_TEXTURE_PATH) {
+        TRACELOG(LOG_ERROR, "Texture path is too long for async loading \"%s\"", filePath);
+        return false;
+    }
+    uint32_t cacheFlags = textureCacheFlags(flipVerticallyOnLoad);
+    if(cacheAcquireTexture(texture, filePath, cacheFlags)) return true;
+
+    _TextureLoadJob *job = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_ASYNC_TEXTURE_LOADS; ++i) {
+        if(atomic_load_explicit(&LOADER.jobs[i].state, memory_order_acquire) == TEXTURE_LOAD_FREE) {
+            job = &LOADER.jobs[i];
+            break;
+        }
+    }
+    if(!job) {
+        TRACELOG(LOG_WARNING, "Too many async texture loads in flight, loading \"%s\" synchronously", filePath);
+        return LoadTextureFromFile(texture, filePath, flipVerticallyOnLoad);
+    }
+
+    const uint8_t placeholder[4] = { 255, 255, 255, 255 };
+    // Not cached until it is uploaded, a texture sharing the placeholder would keep its size forever
+    if(!LoadTexture(texture, placeholder, 1, 1, 4)) return false;
+
+    MemoryCopy(job->filePath, filePath, pathSize);
+    job->flipVerticallyOnLoad = flipVerticallyOnLoad;
+    job->premultiplyAlpha = LOADER.premultiplyAlpha;
+    job->cacheFlags = cacheFlags;
+    job->texture = texture;
+    job->textureID = texture->ID;
+    job->cancelled = false;
+    job->pixels = NULL;
+    job->compressed = false;
+    atomic_store_explicit(&job->state, TEXTURE_LOAD_DECODING, memory_order_relaxed);
+    if(!platformSubmitJob(decodeTextureJob, job)) {
+        // No worker available, decode on this thread and let the next frame upload it
+        decodeTextureJob(job);
+    }
+    return true;
+}
+
+bool IsTextureReady(Texture texture)
+{
+    if(texture.ID == 0) return false;
+    for(uint32_t i = 0; i < MAXIMUM_ASYNC_TEXTURE_LOADS; ++i) {
+        _TextureLoadJob *job = &LOADER.jobs[i];
+        if(job->textureID == texture.ID &&
+                atomic_load_explicit(&job->state, memory_order_acquire) != TEXTURE_LOAD_FREE) return false;
+    }
+    return true;
+}
+
+// Drop the loads still running into `textureID`, their images are thrown away instead of uploaded
+void cancelAsyncTextureLoads(uint32_t textureID)
+{
+    if(textureID == 0) return;
+    for(uint32_t i = 0; i < MAXIMUM_ASYNC_TEXTURE_LOADS; ++i) {
+        _TextureLoadJob *job = &LOADER.jobs[i];
+        if(job->textureID != textureID) continue;
+        if(atomic_load_explicit(&job->state, memory_order_acquire) == TEXTURE_LOAD_FREE) continue;
+        job->textureID = 0;
+        job->cancelled = true;
+    }
+}
+
+void SetTextureUploadBudget(uint32_t microseconds)
+{
+    LOADER.uploadBudget = microseconds;
+}
+
+void SetTextureLoadPremultiply(bool premultiplyAlpha)
+{
+    LOADER.premultiplyAlpha = premultiplyAlpha;
+}
+
+static void freeJobPixels(_TextureLoadJob *job)
+{
+    if(job->pixelsFromStb) stbi_image_free(job->pixels);
+    else MemoryFree(job->pixels);
+    job->pixels = NULL;
+}
+
+// Delete the placeholder of a load that failed, so `IsTextureReady()` stays false for it
+static void failJobTexture(_TextureLoadJob *job)
+{
+    job->textureID = 0; // Keeps `UnloadTexture()` from cancelling this job
+    UnloadTexture(*job->texture);
+    job->texture->ID = 0;
+}
+
+// Upload decoded images until the frame budget is spent, at least one upload happens per call
+void updateAsyncTextureLoads(void)
+{
+    uint64_t start = platformGetTimeMicros();
+    for(uint32_t i = 0; i < MAXIMUM_ASYNC_TEXTURE_LOADS; ++i) {
+        _TextureLoadJob *job = &LOADER.jobs[i];
+        int state = atomic_load_explicit(&job->state, memory_order_acquire);
+        if(state != TEXTURE_LOAD_DECODED && state != TEXTURE_LOAD_FAILED) continue;
+
+        // The texture may have been unloaded while it was decoding
+        if(!job->cancelled && job->texture->ID == job->textureID) {
+            bool uploaded = false;
+            if(state == TEXTURE_LOAD_FAILED) {
+                TRACELOG(LOG_ERROR, "Failed to load texture \"%s\"", job->filePath);
+                failJobTexture(job);
+            } else if(job->compressed) {
+                uploaded = renderUploadTextureCompressed(job->texture, job->pixels, job->width, job->height, job->format, job->mipmaps);
+            } else if(renderStreamTextureImage(job->textureID, job->pixels, job->width, job->height, job->compAmount)) {
+                renderSetTextureInfo(job->texture, job->width, job->height, job->compAmount);
+                uploaded = true;
+            }
+            if(uploaded) {
+                cacheInsertTexture(*job->texture, job->filePath, job->cacheFlags);
+                TRACELOG(LOG_INFO, "Loaded texture \"%s\" with id %u", job->filePath, job->textureID);
+            } else if(state == TEXTURE_LOAD_DECODED) {
+                TRACELOG(LOG_ERROR, "Failed to upload texture \"%s\"", job->filePath);
+                failJobTexture(job);
+            }
+        }
+        if(job->pixels) freeJobPixels(job);
+        job->textureID = 0;
+        atomic_store_explicit(&job->state, TEXTURE_LOAD_FREE, memory_order_release);
+
+        if(platformGetTimeMicros() - start >= LOADER.uploadBudget) break;
+    }
+}
+
+// Call once the workers are stopped, jobs still queued never ran and decoded ones were never uploaded
+void deinitAsyncTextureLoads(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_ASYNC_TEXTURE_LOADS; ++i) {
+        _TextureLoadJob *job = &LOADER.jobs[i];
+        if(atomic_load_explicit(&job->state, memory_order_acquire) == TEXTURE_LOAD_DECODED) freeJobPixels(job);
+        job->pixels = NULL;
+        job->textureID = 0;
+        atomic_store_explicit(&job->state, TEXTURE_LOAD_FREE, memory_order_release);
+    }
+}
@@ -0,0 +1,539 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define PARTICLE_SIMD_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define PARTICLE_SIMD_SSE
+#endif
+
+#ifndef PARTICLE_SIMD_WIDTH
+    #define PARTICLE_SIMD_WIDTH 8
+#endif
+#ifndef PARTICLE_SIMD_ALIGNMENT
+    #define PARTICLE_SIMD_ALIGNMENT 32
+#endif
+
+#define PARTICLE_ARRAY_COUNT 9
+
+enum {
+    GPU_PARTICLE_UPDATE_DELTA_TIME = 0,
+    GPU_PARTICLE_UPDATE_TIME,
+    GPU_PARTICLE_UPDATE_POSITION,
+    GPU_PARTICLE_UPDATE_GRAVITY,
+    GPU_PARTICLE_UPDATE_VELOCITY_MIN,
+    GPU_PARTICLE_UPDATE_VELOCITY_MAX,
+    GPU_PARTICLE_UPDATE_LIFETIME,
+    GPU_PARTICLE_UPDATE_EMITTING,
+};
+
+enum {
+    GPU_PARTICLE_RENDER_TRANSFORM = 0,
+    GPU_PARTICLE_RENDER_SIZE,
+    GPU_PARTICLE_RENDER_COLOR,
+    GPU_PARTICLE_RENDER_TEXTURE,
+};
+
+typedef struct _GPUParticle {
+    float position[2];
+    float velocity[2];
+    float life;
+} _GPUParticle;
+
+static const char *gpuParticleUpdateVertSource =
+    "#version 330 core\n"
+    "layout (location=0) in vec2 a_Position;\n"
+    "layout (location=1) in vec2 a_Velocity;\n"
+    "layout (location=2) in float a_Life;\n"
+    "out vec2 o_Position;\n"
+    "out vec2 o_Velocity;\n"
+    "out float o_Life;\n"
+    "uniform float u_DeltaTime;\n"
+    "uniform float u_Time;\n"
+    "uniform vec2 u_EmitterPosition;\n"
+    "uniform vec2 u_Gravity;\n"
+    "uniform vec2 u_VelocityMin;\n"
+    "uniform vec2 u_VelocityMax;\n"
+    "uniform vec2 u_Lifetime;\n"
+    "uniform int u_Emitting;\n"
+    "float hash(uint x) {\n"
+    "    x ^= x >> 16u; x *= 0x7feb352du; x ^= x >> 15u; x *= 0x846ca68bu; x ^= x >> 16u;\n"
+    "    return float(x >> 8u) / 16777216.0;\n"
+    "}\n"
+    "void main() {\n"
+    "    if(a_Life > 0.0) {\n"
+    "        o_Velocity = a_Velocity + u_Gravity*u_DeltaTime;\n"
+    "        o_Position = a_Position + o_Velocity*u_DeltaTime;\n"
+    "        o_Life = a_Life - u_DeltaTime;\n"
+    "    } else if(u_Emitting != 0) {\n"
+    "        uint seed = uint(gl_VertexID)*3u + floatBitsToUint(u_Time)*7919u;\n"
+    "        vec2 t = vec2(hash(seed), hash(seed + 1u));\n"
+    "        o_Position = u_EmitterPosition;\n"
+    "        o_Velocity = mix(u_VelocityMin, u_VelocityMax, t);\n"
+    "        o_Life = mix(u_Lifetime.x, u_Lifetime.y, hash(seed + 2u));\n"
+    "    } else {\n"
+    "        o_Position = a_Position;\n"
+    "        o_Velocity = a_Velocity;\n"
+    "        o_Life = 0.0;\n"
+    "    }\n"
+    "}\n";
+
+static const char *gpuParticleUpdateFragSource =
+    "#version 330 core\n"
+    "void main() {}\n";
+
+static const char *gpuParticleRenderVertSource =
+    "#version 330 core\n"
+    "layout (location=0) in vec2 a_Position;\n"
+    "layout (location=2) in float a_Life;\n"
+    "uniform mat4 u_Transform;\n"
+    "uniform float u_Size;\n"
+    "out float v_Life;\n"
+    "void main() {\n"
+    "    v_Life = a_Life;\n"
+    "    gl_Position = u_Transform * vec4(a_Position, 0.0, 1.0);\n"
+    "    if(a_Life <= 0.0) gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"
+    "    gl_PointSize = u_Size;\n"
+    "}\n";
+
+static const char *gpuParticleRenderFragSource =
+    "#version 330 core\n"
+    "layout (location=0) out vec4 o_FragColor;\n"
+    "in float v_Life;\n"
+    "uniform vec4 u_Color;\n"
+    "uniform int u_Texture;\n"
+    "uniform sampler2D u_Sampler;\n"
+    "void main() {\n"
+    "    vec4 color = u_Color;\n"
+    "    if(u_Texture != 0) color *= texture(u_Sampler, gl_PointCoord);\n"
+    "    o_FragColor = vec4(color.rgb, color.a*clamp(v_Life, 0.0, 1.0));\n"
+    "}\n";
+
+static uint32_t particleRandom(uint32_t *state)
+{
+    // xorshift32
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static float particleRandomRange(uint32_t *state, float min, float max)
+{
+    float t = (float)(particleRandom(state) >> 8) / (float)(1 << 24);
+    return min + (max - min)*t;
+}
+
+bool LoadParticleEmitter(ParticleEmitter *emitter, uint32_t capacity)
+{
+    if(!emitter) return false;
+    if(capacity == 0) return false;
+
+    capacity = (capacity + PARTICLE_SIMD_WIDTH - 1) & ~(uint32_t)(PARTICLE_SIMD_WIDTH - 1);
+    size_t arraySize = sizeof(float) * capacity;
+    uint8_t *memory = MemoryAlloc(arraySize*PARTICLE_ARRAY_COUNT + PARTICLE_SIMD_ALIGNMENT);
+    if(!memory) {
+        TRACELOG(LOG_ERROR, "Failed to allocate particle emitter with capacity %u", capacity);
+        return false;
+    }
+
+    uint8_t *aligned = (uint8_t *)(((uintptr_t)memory + PARTICLE_SIMD_ALIGNMENT - 1) & ~(uintptr_t)(PARTICLE_SIMD_ALIGNMENT - 1));
+    float **arrays[PARTICLE_ARRAY_COUNT] = {
+        &emitter->positionX, &emitter->positionY,
+        &emitter->velocityX, &emitter->velocityY,
+        &emitter->colorR, &emitter->colorG, &emitter->colorB, &emitter->colorA,
+        &emitter->life,
+    };
+    for(int i = 0; i < PARTICLE_ARRAY_COUNT; ++i)
+        *arrays[i] = (float *)(aligned + arraySize*i);
+
+    emitter->memory = memory;
+    emitter->capacity = capacity;
+    emitter->count = 0;
+    emitter->position = CLITERAL(Vector2){ .x=0.0f, .y=0.0f };
+    emitter->gravity = CLITERAL(Vector2){ .x=0.0f, .y=0.0f };
+    emitter->velocityMin = CLITERAL(Vector2){ .x=-50.0f, .y=-50.0f };
+    emitter->velocityMax = CLITERAL(Vector2){ .x=50.0f, .y=50.0f };
+    emitter->lifetimeMin = 1.0f;
+    emitter->lifetimeMax = 2.0f;
+    emitter->fadePerSecond = 0.5f;
+    emitter->size = 4.0f;
+    emitter->color = WHITE;
+    emitter->seed = 0x9E3779B9u;
+    return true;
+}
+
+void UnloadParticleEmitter(ParticleEmitter *emitter)
+{
+    if(!emitter) return;
+    MemoryFree(emitter->memory);
+    MemorySet(emitter, 0, sizeof(*emitter));
+}
+
+uint32_t EmitParticles(ParticleEmitter *emitter, uint32_t amount)
+{
+    if(!emitter) return 0;
+    if(emitter->count + amount > emitter->capacity) amount = emitter->capacity - emitter->count;
+    if(emitter->seed == 0) emitter->seed = 0x9E3779B9u;
+
+    float r = (float)emitter->color.r/255.0f;
+    float g = (float)emitter->color.g/255.0f;
+    float b = (float)emitter->color.b/255.0f;
+    float a = (float)emitter->color.a/255.0f;
+    for(uint32_t i = emitter->count; i < emitter->count + amount; ++i) {
+        emitter->positionX[i] = emitter->position.x;
+        emitter->positionY[i] = emitter->position.y;
+        emitter->velocityX[i] = particleRandomRange(&emitter->seed, emitter->velocityMin.x, emitter->velocityMax.x);
+        emitter->velocityY[i] = particleRandomRange(&emitter->seed, emitter->velocityMin.y, emitter->velocityMax.y);
+        emitter->colorR[i] = r;
+        emitter->colorG[i] = g;
+        emitter->colorB[i] = b;
+        emitter->colorA[i] = a;
+        emitter->life[i] = particleRandomRange(&emitter->seed, emitter->lifetimeMin, emitter->lifetimeMax);
+    }
+    emitter->count += amount;
+    return amount;
+}
+
+/**
+ * Integrate particles in [first, first + amount). Only the given range is touched, so disjoint
+ * ranges of the same emitter can be updated from different threads. Dead particles are kept
+ * until `RemoveDeadParticles()` is called.
+ */
+void UpdateParticlesRange(ParticleEmitter *emitter, float deltaTime, uint32_t first, uint32_t amount)
+{
+    if(!emitter) return;
+    if(first >= emitter->count) return;
+    if(first + amount > emitter->count) amount = emitter->count - first;
+
+    float *px = emitter->positionX + first;
+    float *py = emitter->positionY + first;
+    float *vx = emitter->velocityX + first;
+    float *vy = emitter->velocityY + first;
+    float *alpha = emitter->colorA + first;
+    float *life = emitter->life + first;
+    float gx = emitter->gravity.x*deltaTime;
+    float gy = emitter->gravity.y*deltaTime;
+    float fade = emitter->fadePerSecond*deltaTime;
+    uint32_t i = 0;
+
+#if defined(PARTICLE_SIMD_AVX)
+    __m256 dt8 = _mm256_set1_ps(deltaTime);
+    __m256 gx8 = _mm256_set1_ps(gx);
+    __m256 gy8 = _mm256_set1_ps(gy);
+    __m256 fade8 = _mm256_set1_ps(fade);
+    __m256 zero8 = _mm256_setzero_ps();
+    for(; i + 8 <= amount; i += 8) {
+        __m256 vx8 = _mm256_add_ps(_mm256_loadu_ps(vx + i), gx8);
+        __m256 vy8 = _mm256_add_ps(_mm256_loadu_ps(vy + i), gy8);
+        _mm256_storeu_ps(vx + i, vx8);
+        _mm256_storeu_ps(vy + i, vy8);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(vx8, dt8)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(vy8, dt8)));
+        _mm256_storeu_ps(alpha + i, _mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(alpha + i), fade8), zero8));
+        _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), dt8));
+    }
+#elif defined(PARTICLE_SIMD_SSE)
+    __m128 dt4 = _mm_set1_ps(deltaTime);
+    __m128 gx4 = _mm_set1_ps(gx);
+    __m128 gy4 = _mm_set1_ps(gy);
+    __m128 fade4 = _mm_set1_ps(fade);
+    __m128 zero4 = _mm_setzero_ps();
+    for(; i + 4 <= amount; i += 4) {
+        __m128 vx4 = _mm_add_ps(_mm_loadu_ps(vx + i), gx4);
+        __m128 vy4 = _mm_add_ps(_mm_loadu_ps(vy + i), gy4);
+        _mm_storeu_ps(vx + i, vx4);
+        _mm_storeu_ps(vy + i, vy4);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(vx4, dt4)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(vy4, dt4)));
+        _mm_storeu_ps(alpha + i, _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(alpha + i), fade4), zero4));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt4));
+    }
+#endif
+
+    for(; i < amount; ++i) {
+        vx[i] += gx;
+        vy[i] += gy;
+        px[i] += vx[i]*deltaTime;
+        py[i] += vy[i]*deltaTime;
+        alpha[i] = (alpha[i] - fade) > 0.0f ? (alpha[i] - fade) : 0.0f;
+        life[i] -= deltaTime;
+    }
+}
+
+void RemoveDeadParticles(ParticleEmitter *emitter)
+{
+    if(!emitter) return;
+    float **arrays[PARTICLE_ARRAY_COUNT] = {
+        &emitter->positionX, &emitter->positionY,
+        &emitter->velocityX, &emitter->velocityY,
+        &emitter->colorR, &emitter->colorG, &emitter->colorB, &emitter->colorA,
+        &emitter->life,
+    };
+
+    uint32_t i = 0;
+    while(i < emitter->count) {
+        if(emitter->life[i] > 0.0f) {
+            i += 1;
+            continue;
+        }
+        // Swap the last alive particle into the dead slot
+        uint32_t last = emitter->count - 1;
+        for(int j = 0; j < PARTICLE_ARRAY_COUNT; ++j)
+            (*arrays[j])[i] = (*arrays[j])[last];
+        emitter->count -= 1;
+    }
+}
+
+void UpdateParticles(ParticleEmitter *emitter, float deltaTime)
+{
+    if(!emitter) return;
+    UpdateParticlesRange(emitter, deltaTime, 0, emitter->count);
+    RemoveDeadParticles(emitter);
+}
+
+void DrawParticles(const ParticleEmitter *emitter, Texture texture, Shader shader)
+{
+    if(!emitter) return;
+    float halfSize = emitter->size*0.5f;
+    uint32_t i = 0;
+
+    while(i < emitter->count) {
+        float textureIndex = texture.ID ? (float)RenderEnableTexture(texture) : -1.0f;
+        uint32_t *elements = NULL;
+        uint32_t firstVertex = 0;
+        uint32_t roomVertices, roomElements;
+
+        // Take as many quads as the batch has room for, flush when it is full
+        renderGetBatchRoom(&roomVertices, &roomElements);
+        uint32_t amount = emitter->count - i;
+        if(amount > roomVertices/4) amount = roomVertices/4;
+        if(amount > roomElements/6) amount = roomElements/6;
+        if(amount == 0) {
+            RenderFlush(shader);
+            continue;
+        }
+        _RenderVertex *vertices = renderReserveVertices(amount*4, amount*6, &elements, &firstVertex);
+
+        for(uint32_t j = 0; j < amount; ++j, ++i) {
+            float x0 = emitter->positionX[i] - halfSize;
+            float y0 = emitter->positionY[i] - halfSize;
+            float x1 = emitter->positionX[i] + halfSize;
+            float y1 = emitter->positionY[i] + halfSize;
+            float corners[4][4] = {
+                { x0, y0, 0.0f, 0.0f },
+                { x1, y0, 1.0f, 0.0f },
+                { x1, y1, 1.0f, 1.0f },
+                { x0, y1, 0.0f, 1.0f },
+            };
+            for(int k = 0; k < 4; ++k) {
+                _RenderVertex *v = &vertices[j*4 + k];
+                v->pos.x = corners[k][0];
+                v->pos.y = corners[k][1];
+                v->pos.z = 0.0f;
+                v->color.r = emitter->colorR[i];
+                v->color.g = emitter->colorG[i];
+                v->color.b = emitter->colorB[i];
+                v->color.a = emitter->colorA[i];
+                v->texCoords.u = corners[k][2];
+                v->texCoords.v = corners[k][3];
+                v->textureIndex = textureIndex;
+            }
+
+            uint32_t base = firstVertex + j*4;
+            elements[j*6 + 0] = base + 0;
+            elements[j*6 + 1] = base + 1;
+            elements[j*6 + 2] = base + 2;
+            elements[j*6 + 3] = base + 2;
+            elements[j*6 + 4] = base + 3;
+            elements[j*6 + 5] = base + 0;
+        }
+    }
+}
+
+static uint32_t compileGPUParticleProgram(const char *vertSource, const char *fragSource, const char **varyings, int varyingCount)
+{
+    const char *sources[2] = { vertSource, fragSource };
+    uint32_t types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+    uint32_t modules[2] = { 0, 0 };
+    int success;
+
+    for(int i = 0; i < 2; ++i) {
+        modules[i] = glCreateShader(types[i]);
+        glShaderSource(modules[i], 1, &sources[i], NULL);
+        glCompileShader(modules[i]);
+        glGetShaderiv(modules[i], GL_COMPILE_STATUS, &success);
+        if(!success) {
+            char info_log[512];
+            glGetShaderInfoLog(modules[i], sizeof(info_log), NULL, info_log);
+            TRACELOG(LOG_ERROR, "GPU particle shader compilation error \"%s\"", info_log);
+            glDeleteShader(modules[0]);
+            if(modules[1]) glDeleteShader(modules[1]);
+            return 0;
+        }
+    }
+
+    uint32_t program = glCreateProgram();
+    glAttachShader(program, modules[0]);
+    glAttachShader(program, modules[1]);
+    if(varyings) glTransformFeedbackVaryings(program, varyingCount, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDeleteShader(modules[0]);
+    glDeleteShader(modules[1]);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if(!success) {
+        char info_log[512];
+        glGetProgramInfoLog(program, sizeof(info_log), NULL, info_log);
+        TRACELOG(LOG_ERROR, "GPU particle shader linking error: %s", info_log);
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+bool LoadGPUParticleSystem(GPUParticleSystem *system, uint32_t capacity)
+{
+    if(!system) return false;
+    if(capacity == 0) return false;
+
+    const char *varyings[] = { "o_Position", "o_Velocity", "o_Life" };
+    system->updateProgramID = compileGPUParticleProgram(gpuParticleUpdateVertSource, gpuParticleUpdateFragSource, varyings, 3);
+    if(!system->updateProgramID) return false;
+    system->renderProgramID = compileGPUParticleProgram(gpuParticleRenderVertSource, gpuParticleRenderFragSource, NULL, 0);
+    if(!system->renderProgramID) {
+        glDeleteProgram(system->updateProgramID);
+        return false;
+    }
+
+    system->updateLocs[GPU_PARTICLE_UPDATE_DELTA_TIME] = glGetUniformLocation(system->updateProgramID, "u_DeltaTime");
+    system->updateLocs[GPU_PARTICLE_UPDATE_TIME] = glGetUniformLocation(system->updateProgramID, "u_Time");
+    system->updateLocs[GPU_PARTICLE_UPDATE_POSITION] = glGetUniformLocation(system->updateProgramID, "u_EmitterPosition");
+    system->updateLocs[GPU_PARTICLE_UPDATE_GRAVITY] = glGetUniformLocation(system->updateProgramID, "u_Gravity");
+    system->updateLocs[GPU_PARTICLE_UPDATE_VELOCITY_MIN] = glGetUniformLocation(system->updateProgramID, "u_VelocityMin");
+    system->updateLocs[GPU_PARTICLE_UPDATE_VELOCITY_MAX] = glGetUniformLocation(system->updateProgramID, "u_VelocityMax");
+    system->updateLocs[GPU_PARTICLE_UPDATE_LIFETIME] = glGetUniformLocation(system->updateProgramID, "u_Lifetime");
+    system->updateLocs[GPU_PARTICLE_UPDATE_EMITTING] = glGetUniformLocation(system->updateProgramID, "u_Emitting");
+    system->renderLocs[GPU_PARTICLE_RENDER_TRANSFORM] = glGetUniformLocation(system->renderProgramID, "u_Transform");
+    system->renderLocs[GPU_PARTICLE_RENDER_SIZE] = glGetUniformLocation(system->renderProgramID, "u_Size");
+    system->renderLocs[GPU_PARTICLE_RENDER_COLOR] = glGetUniformLocation(system->renderProgramID, "u_Color");
+    system->renderLocs[GPU_PARTICLE_RENDER_TEXTURE] = glGetUniformLocation(system->renderProgramID, "u_Texture");
+
+    // Every particle starts dead, so the first update spawns them all
+    size_t bufferSize = sizeof(_GPUParticle) * capacity;
+    _GPUParticle *initial = MemoryAlloc(bufferSize);
+    if(!initial) {
+        glDeleteProgram(system->updateProgramID);
+        glDeleteProgram(system->renderProgramID);
+        return false;
+    }
+    MemorySet(initial, 0, bufferSize);
+
+    glGenVertexArrays(2, system->vaoIDs);
+    glGenBuffers(2, system->vboIDs);
+    for(int i = 0; i < 2; ++i) {
+        glBindVertexArray(system->vaoIDs[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, system->vboIDs[i]);
+        glBufferData(GL_ARRAY_BUFFER, bufferSize, initial, GL_DYNAMIC_COPY);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(_GPUParticle), (void*)offsetof(_GPUParticle, position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(_GPUParticle), (void*)offsetof(_GPUParticle, velocity));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(_GPUParticle), (void*)offsetof(_GPUParticle, life));
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    MemoryFree(initial);
+
+    system->capacity = capacity;
+    system->current = 0;
+    system->time = 0.0f;
+    system->position = CLITERAL(Vector2){ .x=0.0f, .y=0.0f };
+    system->gravity = CLITERAL(Vector2){ .x=0.0f, .y=0.0f };
+    system->velocityMin = CLITERAL(Vector2){ .x=-50.0f, .y=-50.0f };
+    system->velocityMax = CLITERAL(Vector2){ .x=50.0f, .y=50.0f };
+    system->lifetimeMin = 1.0f;
+    system->lifetimeMax = 2.0f;
+    system->size = 4.0f;
+    system->color = WHITE;
+    system->emitting = true;
+    TRACELOG(LOG_INFO, "Loaded GPU particle system with %u particles", capacity);
+    return true;
+}
+
+void UnloadGPUParticleSystem(GPUParticleSystem *system)
+{
+    if(!system) return;
+    glDeleteVertexArrays(2, system->vaoIDs);
+    glDeleteBuffers(2, system->vboIDs);
+    glDeleteProgram(system->updateProgramID);
+    glDeleteProgram(system->renderProgramID);
+    MemorySet(system, 0, sizeof(*system));
+}
+
+void UpdateGPUParticles(GPUParticleSystem *system, float deltaTime)
+{
+    if(!system || !system->capacity) return;
+    uint32_t next = 1 - system->current;
+    system->time += deltaTime;
+
+    glUseProgram(system->updateProgramID);
+    glUniform1f(system->updateLocs[GPU_PARTICLE_UPDATE_DELTA_TIME], deltaTime);
+    glUniform1f(system->updateLocs[GPU_PARTICLE_UPDATE_TIME], system->time);
+    glUniform2f(system->updateLocs[GPU_PARTICLE_UPDATE_POSITION], system->position.x, system->position.y);
+    glUniform2f(system->updateLocs[GPU_PARTICLE_UPDATE_GRAVITY], system->gravity.x, system->gravity.y);
+    glUniform2f(system->updateLocs[GPU_PARTICLE_UPDATE_VELOCITY_MIN], system->velocityMin.x, system->velocityMin.y);
+    glUniform2f(system->updateLocs[GPU_PARTICLE_UPDATE_VELOCITY_MAX], system->velocityMax.x, system->velocityMax.y);
+    glUniform2f(system->updateLocs[GPU_PARTICLE_UPDATE_LIFETIME], system->lifetimeMin, system->lifetimeMax);
+    glUniform1i(system->updateLocs[GPU_PARTICLE_UPDATE_EMITTING], system->emitting ? 1 : 0);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(system->vaoIDs[system->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, system->vboIDs[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, system->capacity);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    glUseProgram(0);
+
+    system->current = next;
+}
+
+/**
+ * Draw the particles as point sprites straight from the simulation buffer. This is not batched,
+ * flush pending batch geometry first if it has to appear behind the particles. Blends with the mode of
+ * `BeginBlendMode()`.
+ */
+void DrawGPUParticles(const GPUParticleSystem *system, Texture texture, Matrix transform)
+{
+    if(!system || !system->capacity) return;
+
+    glUseProgram(system->renderProgramID);
+    glUniformMatrix4fv(system->renderLocs[GPU_PARTICLE_RENDER_TRANSFORM], 1, GL_FALSE, transform.elements);
+    glUniform1f(system->renderLocs[GPU_PARTICLE_RENDER_SIZE], system->size);
+    glUniform4f(system->renderLocs[GPU_PARTICLE_RENDER_COLOR],
+            (float)system->color.r/255.0f, (float)system->color.g/255.0f,
+            (float)system->color.b/255.0f, (float)system->color.a/255.0f);
+    glUniform1i(system->renderLocs[GPU_PARTICLE_RENDER_TEXTURE], texture.ID ? 1 : 0);
+    if(texture.ID) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, texture.ID);
+        glBindSampler(0, texture.samplerID);
+    }
+    renderApplyCurrentBlendMode();
+
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glBindVertexArray(system->vaoIDs[system->current]);
+    glDrawArrays(GL_POINTS, 0, system->capacity);
+    glBindVertexArray(0);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glUseProgram(0);
+}
@@ -0,0 +1,258 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#ifndef MAXIMUM_SHADER_STAGES
+    #define MAXIMUM_SHADER_STAGES 64
+#endif
+#ifndef MAXIMUM_SHADER_PIPELINES
+    #define MAXIMUM_SHADER_PIPELINES 256
+#endif
+
+/**
+ * Program of a single stage, linked on its own so any number of pipelines combine it without linking again.
+ * Pipelines hold a reference, a stage unloaded while one still uses it goes with the last of them.
+ */
+typedef struct _ShaderStage {
+    uint32_t programID; // 0 without separate shader objects, pipelines link a program from `source` then
+    int type; // `NoeShaderStage`
+    char *source;
+    uint32_t refCount; // 0 for a free stage
+} _ShaderStage;
+
+// Vertex and fragment stage bound together, loading the same pair again shares the pipeline
+typedef struct _ShaderPipeline {
+    uint32_t vertStage, fragStage; // `ShaderStage.ID`s, 0 for a free pipeline
+    Shader shader; // ID is a program pipeline object, or a linked program without separate shader objects
+    uint32_t refCount;
+} _ShaderPipeline;
+
+static struct {
+    _ShaderStage stages[MAXIMUM_SHADER_STAGES];
+    _ShaderPipeline pipelines[MAXIMUM_SHADER_PIPELINES];
+    bool checkedSupport, supported;
+    uint32_t created, shared;
+} PIPELINES = {0};
+
+static bool hasSeparateShaders(void)
+{
+    if(!PIPELINES.checkedSupport) {
+        PIPELINES.supported = renderHasSeparateShaders();
+        PIPELINES.checkedSupport = true;
+        if(!PIPELINES.supported) TRACELOG(LOG_WARNING, "OpenGL driver has no separate shader objects, shader pipelines link a program each");
+    }
+    return PIPELINES.supported;
+}
+
+static bool isPipelineShader(Shader shader)
+{
+    return shader.variables && shader.variables->vertProgram != 0;
+}
+
+static _ShaderStage *getStage(ShaderStage stage)
+{
+    if(stage.ID == 0 || stage.ID > MAXIMUM_SHADER_STAGES) return NULL;
+    _ShaderStage *result = &PIPELINES.stages[stage.ID - 1];
+    return result->refCount > 0 ? result : NULL;
+}
+
+static void releaseStage(_ShaderStage *stage)
+{
+    stage->refCount -= 1;
+    if(stage->refCount > 0) return;
+    if(stage->programID != 0) glDeleteProgram(stage->programID);
+    MemoryFree(stage->source);
+    MemorySet(stage, 0, sizeof(*stage));
+}
+
+static void deletePipeline(_ShaderPipeline *pipeline)
+{
+    Shader shader = pipeline->shader;
+    if(isPipelineShader(shader)) glDeleteProgramPipelines(1, &shader.ID);
+    else glDeleteProgram(shader.ID);
+    freeShaderVariables(shader);
+    MemoryFree(shader.locs);
+    releaseStage(&PIPELINES.stages[pipeline->vertStage - 1]);
+    releaseStage(&PIPELINES.stages[pipeline->fragStage - 1]);
+    MemorySet(pipeline, 0, sizeof(*pipeline));
+}
+
+static bool createPipeline(Shader *shader, const _ShaderStage *vert, const _ShaderStage *frag)
+{
+    shader->locs = NULL;
+    shader->variables = NULL;
+    glGenProgramPipelines(1, &shader->ID);
+    glUseProgramStages(shader->ID, GL_VERTEX_SHADER_BIT, vert->programID);
+    glUseProgramStages(shader->ID, GL_FRAGMENT_SHADER_BIT, frag->programID);
+
+    // Catches what linking the stages together would have, draws with an invalid pipeline fail
+    int valid = 0;
+    glValidateProgramPipeline(shader->ID);
+    glGetProgramPipelineiv(shader->ID, GL_VALIDATE_STATUS, &valid);
+    if(!valid) {
+        char info_log[512] = {0};
+        glGetProgramPipelineInfoLog(shader->ID, sizeof(info_log), NULL, info_log);
+        TRACELOG(LOG_ERROR, "Shader pipeline validation error \"%s\"", info_log);
+    } else {
+        shader->locs = MemoryAlloc(sizeof(int) * MAXIMUM_SHADER_LOCS);
+        if(shader->locs && reflectPipelineVariables(shader, vert->programID, frag->programID) &&
+                renderFindShaderLocations(*shader, shader->locs)) return true;
+    }
+
+    freeShaderVariables(*shader);
+    MemoryFree(shader->locs);
+    glDeleteProgramPipelines(1, &shader->ID);
+    *shader = CLITERAL(Shader){0};
+    return false;
+}
+
+/**
+ * Compile and link one stage on its own, `stageType` is a `NoeShaderStage`.
+ * Stages are combined by `LoadShaderPipeline()` without linking them again,
+ * so N vertex and M fragment stages cost N + M links instead of N * M.
+ */
+bool LoadShaderStage(ShaderStage *stage, int stageType, const char *source)
+{
+    if(!stage) return false;
+    if(!source) return false;
+    if(stageType != SHADER_STAGE_VERTEX && stageType != SHADER_STAGE_FRAGMENT) return false;
+    stage->ID = 0;
+
+    _ShaderStage *empty = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_STAGES && !empty; ++i) {
+        if(PIPELINES.stages[i].refCount == 0) empty = &PIPELINES.stages[i];
+    }
+    if(!empty) {
+        TRACELOG(LOG_ERROR, "Too many shader stages (%d)", MAXIMUM_SHADER_STAGES);
+        return false;
+    }
+
+    if(hasSeparateShaders()) {
+        uint32_t program = glCreateShaderProgramv(stageType == SHADER_STAGE_VERTEX ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER,
+                1, &source);
+        int success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if(!success) {
+            char info_log[512] = {0};
+            glGetProgramInfoLog(program, sizeof(info_log), NULL, info_log);
+            TRACELOG(LOG_ERROR, "%s shader stage compilation error \"%s\"",
+                    stageType == SHADER_STAGE_VERTEX ? "Vertex" : "Fragment", info_log);
+            glDeleteProgram(program);
+            return false;
+        }
+        empty->programID = program;
+    } else {
+        size_t size = StringLength(source);
+        empty->source = MemoryAlloc(size);
+        if(!empty->source) return false;
+        MemoryCopy(empty->source, source, size);
+    }
+    empty->type = stageType;
+    empty->refCount = 1;
+    stage->ID = (uint32_t)(empty - PIPELINES.stages) + 1;
+    return true;
+}
+
+/**
+ * Shader drawing with a vertex and a fragment stage, bound as a program pipeline by `RenderFlush()`.
+ * Loading the same pair again shares the pipeline, `UnloadShader()` releases it.
+ * Uniforms belong to the stages, setting one sets it for every pipeline sharing that stage and is
+ * uploaded right away instead of staged. One declared by both stages is set in both of them.
+ * Without separate shader objects the stages are linked into a program here instead.
+ */
+bool LoadShaderPipeline(Shader *shader, ShaderStage vertStage, ShaderStage fragStage)
+{
+    if(!shader) return false;
+    _ShaderStage *vert = getStage(vertStage);
+    _ShaderStage *frag = getStage(fragStage);
+    if(!vert || !frag) return false;
+    if(vert->type != SHADER_STAGE_VERTEX || frag->type != SHADER_STAGE_FRAGMENT) {
+        TRACELOG(LOG_ERROR, "Shader pipeline needs a vertex and a fragment stage");
+        return false;
+    }
+
+    _ShaderPipeline *empty = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_PIPELINES; ++i) {
+        _ShaderPipeline *pipeline = &PIPELINES.pipelines[i];
+        if(pipeline->vertStage == vertStage.ID && pipeline->fragStage == fragStage.ID) {
+            pipeline->refCount += 1;
+            PIPELINES.shared += 1;
+            *shader = pipeline->shader;
+            return true;
+        }
+        if(pipeline->vertStage == 0 && !empty) empty = pipeline;
+    }
+    if(!empty) {
+        TRACELOG(LOG_ERROR, "Too many shader pipelines (%d)", MAXIMUM_SHADER_PIPELINES);
+        return false;
+    }
+
+    Shader result = {0};
+    bool success = vert->programID != 0 ? createPipeline(&result, vert, frag) :
+        LoadShader(&result, vert->source, frag->source);
+    if(!success) return false;
+
+    vert->refCount += 1;
+    frag->refCount += 1;
+    empty->vertStage = vertStage.ID;
+    empty->fragStage = fragStage.ID;
+    empty->shader = result;
+    empty->refCount = 1;
+    PIPELINES.created += 1;
+    *shader = result;
+    return true;
+}
+
+// Pipelines using the stage keep it until they are unloaded
+void UnloadShaderStage(ShaderStage stage)
+{
+    _ShaderStage *result = getStage(stage);
+    if(result) releaseStage(result);
+}
+
+void pipelineBindShader(Shader shader)
+{
+    if(isPipelineShader(shader)) {
+        // A program made current with `glUseProgram()` takes precedence over the bound pipeline
+        glUseProgram(0);
+        glBindProgramPipeline(shader.ID);
+    } else {
+        glUseProgram(shader.ID);
+    }
+}
+
+void pipelineUnbindShader(Shader shader)
+{
+    if(isPipelineShader(shader)) glBindProgramPipeline(0);
+    else glUseProgram(0);
+}
+
+bool pipelineReleaseShader(Shader shader)
+{
+    // Pipeline and program names overlap, `locs` is only shared by copies of the same shader
+    if(!shader.locs) return false;
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_PIPELINES; ++i) {
+        _ShaderPipeline *pipeline = &PIPELINES.pipelines[i];
+        if(pipeline->vertStage == 0 || pipeline->shader.locs != shader.locs) continue;
+        pipeline->refCount -= 1;
+        if(pipeline->refCount == 0) deletePipeline(pipeline);
+        return true;
+    }
+    return false;
+}
+
+void deinitShaderPipelines(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_PIPELINES; ++i) {
+        if(PIPELINES.pipelines[i].vertStage != 0) deletePipeline(&PIPELINES.pipelines[i]);
+    }
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_STAGES; ++i) {
+        _ShaderStage *stage = &PIPELINES.stages[i];
+        if(stage->refCount == 0) continue;
+        stage->refCount = 1;
+        releaseStage(stage);
+    }
+    if(PIPELINES.created > 0) TRACELOG(LOG_INFO, "Shader pipelines: %u created, %u shared", PIPELINES.created, PIPELINES.shared);
+    MemorySet(&PIPELINES, 0, sizeof(PIPELINES));
+}
@@ -5,13 +5,23 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <sys/time.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
 
 #ifdef NOE_LINUX_DISPLAY_X11
+// X11 declares its own `Font`, keep it out of the way of noe's `Font`
+#define Font X11Font
 #include <X11/Xlib.h>
 #include <X11/keysym.h>
 #include <X11/Xutil.h>
 #include <GL/glx.h>
 #include <EGL/egl.h>
+#undef Font
 
 typedef struct _PlatformDisplayState {
     Display *handle;
@@ -489,6 +499,11 @@ void SwapBufferGL(void)
     }
 }
 
+void *GetProcGL(const char *procName)
+{
+    return (void *)glXGetProcAddressARB((const GLubyte *)procName);
+}
+
 void platformDeinit(void)
 {
     if(!PLATFORM.initialized) return;
@@ -573,6 +588,10 @@ void platformPollEvent(_InputManager *inputs)
             case ButtonRelease:
                 {
                 } break;
+            case ConfigureNotify:
+                {
+                    setApplicationWindowSize((uint32_t)event.xconfigure.width, (uint32_t)event.xconfigure.height);
+                } break;
             default:
                 break;
         }
@@ -810,7 +829,183 @@ void MemoryFree(void *ptr)
     if(ptr) free(ptr);
 }
 
+uint64_t platformGetTimeMicros(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000 + (uint64_t)ts.tv_nsec/1000;
+}
+
 uint64_t GetTimeMilis(void)
 {
-    return 0;
+    return platformGetTimeMicros()/1000;
+}
+
+bool platformMakeDirectory(const char *directoryPath)
+{
+    if(mkdir(directoryPath, 0755) == 0) return true;
+    return errno == EEXIST;
+}
+
+static struct {
+    int fd;
+    size_t offset, length; // Events read but not handed out yet
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+} WATCHER = { .fd = -1 };
+
+/**
+ * Watch the directory of `filePath` instead of the file itself, editors often save by
+ * writing a new file and renaming it over the old one, which a watch on the file would miss.
+ * Files in the same directory share a watch handle.
+ */
+int platformWatchFile(const char *filePath)
+{
+    if(WATCHER.fd < 0) {
+        WATCHER.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(WATCHER.fd < 0) {
+            TRACELOG(LOG_WARNING, "Failed to start watching files (errno %d)", errno);
+            return -1;
+        }
+    }
+
+    char directory[4096] = ".";
+    const char *separator = NULL;
+    for(const char *p = filePath; *p; ++p) {
+        if(*p == '/') separator = p;
+    }
+    if(separator) {
+        size_t length = (size_t)(separator - filePath);
+        if(length == 0) length = 1; // File in the root directory
+        if(length >= sizeof(directory)) return -1;
+        MemoryCopy(directory, filePath, length);
+        directory[length] = '\0';
+    }
+    int watch = inotify_add_watch(WATCHER.fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO);
+    if(watch < 0) TRACELOG(LOG_WARNING, "Failed to watch \"%s\" (errno %d)", directory, errno);
+    return watch;
+}
+
+// Name of the next file written in a watched directory, false once there is none, never blocks
+bool platformPollFileChange(int *watch, char *fileName, size_t fileNameSize)
+{
+    if(WATCHER.fd < 0) return false;
+    for(;;) {
+        if(WATCHER.offset >= WATCHER.length) {
+            ssize_t length = read(WATCHER.fd, WATCHER.buffer, sizeof(WATCHER.buffer));
+            if(length <= 0) return false;
+            WATCHER.offset = 0;
+            WATCHER.length = (size_t)length;
+        }
+        const struct inotify_event *event = (const struct inotify_event *)&WATCHER.buffer[WATCHER.offset];
+        WATCHER.offset += sizeof(struct inotify_event) + event->len;
+        if(event->len == 0) continue;
+        size_t nameSize = StringLength(event->name);
+        if(nameSize > fileNameSize) continue;
+        *watch = event->wd;
+        MemoryCopy(fileName, event->name, nameSize);
+        return true;
+    }
+}
+
+void platformDeinitFileWatcher(void)
+{
+    if(WATCHER.fd >= 0) close(WATCHER.fd);
+    WATCHER.fd = -1;
+    WATCHER.offset = WATCHER.length = 0;
+}
+
+typedef struct _PlatformWorkers {
+    bool initialized;
+    bool shouldQuit;
+    pthread_t threads[MAXIMUM_WORKER_THREADS];
+    uint32_t threadCount;
+    pthread_mutex_t mutex;
+    pthread_cond_t jobAvailable;
+    struct {
+        _WorkerJobFunc func;
+        void *userData;
+    } jobs[MAXIMUM_WORKER_JOBS];
+    uint32_t jobHead, jobCount;
+} _PlatformWorkers;
+
+static _PlatformWorkers WORKERS = {0};
+
+static void *workerThreadMain(void *arg)
+{
+    (void)arg;
+    for(;;) {
+        pthread_mutex_lock(&WORKERS.mutex);
+        while(WORKERS.jobCount == 0 && !WORKERS.shouldQuit)
+            pthread_cond_wait(&WORKERS.jobAvailable, &WORKERS.mutex);
+        if(WORKERS.shouldQuit) {
+            pthread_mutex_unlock(&WORKERS.mutex);
+            return NULL;
+        }
+        _WorkerJobFunc func = WORKERS.jobs[WORKERS.jobHead].func;
+        void *userData = WORKERS.jobs[WORKERS.jobHead].userData;
+        WORKERS.jobHead = (WORKERS.jobHead + 1) % MAXIMUM_WORKER_JOBS;
+        WORKERS.jobCount -= 1;
+        pthread_mutex_unlock(&WORKERS.mutex);
+
+        func(userData);
+    }
+}
+
+bool platformInitWorkers(uint32_t workerCount)
+{
+    if(WORKERS.initialized) return true;
+    if(workerCount > MAXIMUM_WORKER_THREADS) workerCount = MAXIMUM_WORKER_THREADS;
+
+    pthread_mutex_init(&WORKERS.mutex, NULL);
+    pthread_cond_init(&WORKERS.jobAvailable, NULL);
+    WORKERS.shouldQuit = false;
+    WORKERS.jobHead = 0;
+    WORKERS.jobCount = 0;
+    WORKERS.threadCount = 0;
+    for(uint32_t i = 0; i < workerCount; ++i) {
+        if(pthread_create(&WORKERS.threads[i], NULL, workerThreadMain, NULL) != 0) {
+            TRACELOG(LOG_WARNING, "Failed to create worker thread %u", i);
+            break;
+        }
+        WORKERS.threadCount += 1;
+    }
+    WORKERS.initialized = true;
+    TRACELOG(LOG_INFO, "Started %u worker threads", WORKERS.threadCount);
+    return WORKERS.threadCount > 0;
+}
+
+void platformDeinitWorkers(void)
+{
+    if(!WORKERS.initialized) return;
+    pthread_mutex_lock(&WORKERS.mutex);
+    WORKERS.shouldQuit = true;
+    pthread_cond_broadcast(&WORKERS.jobAvailable);
+    pthread_mutex_unlock(&WORKERS.mutex);
+    for(uint32_t i = 0; i < WORKERS.threadCount; ++i)
+        pthread_join(WORKERS.threads[i], NULL);
+    pthread_cond_destroy(&WORKERS.jobAvailable);
+    pthread_mutex_destroy(&WORKERS.mutex);
+    WORKERS.initialized = false;
+}
+
+bool platformSubmitJob(_WorkerJobFunc func, void *userData)
+{
+    if(!WORKERS.initialized || WORKERS.threadCount == 0) return false;
+    pthread_mutex_lock(&WORKERS.mutex);
+    if(WORKERS.jobCount == MAXIMUM_WORKER_JOBS) {
+        pthread_mutex_unlock(&WORKERS.mutex);
+        return false;
+    }
+    uint32_t index = (WORKERS.jobHead + WORKERS.jobCount) % MAXIMUM_WORKER_JOBS;
+    WORKERS.jobs[index].func = func;
+    WORKERS.jobs[index].userData = userData;
+    WORKERS.jobCount += 1;
+    pthread_cond_signal(&WORKERS.jobAvailable);
+    pthread_mutex_unlock(&WORKERS.mutex);
+    return true;
+}
+
+void platformYieldThread(void)
+{
+    sched_yield();
 }
@@ -3,6 +3,7 @@
 #include "noe_internal.h"
 
 #include "windows.h"
+#include <stdio.h>
 
 typedef struct _PlatformWindowState {
     HWND hWnd;
@@ -134,6 +135,11 @@ void SwapBufferGL(void)
 {
 }
 
+void *GetProcGL(const char *procName)
+{
+    return (void *)wglGetProcAddress(procName);
+}
+
 int win32GetKeyMods(void)
 {
     int mods = 0;
@@ -297,6 +303,7 @@ LRESULT CALLBACK win32WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
                 GetClientRect(hWnd, &r);
                 int window_width = r.right - r.left;
                 int window_height= r.bottom - r.top;
+                setApplicationWindowSize((uint32_t)window_width, (uint32_t)window_height);
             } break;
         case WM_KEYDOWN:
         case WM_SYSKEYDOWN:
@@ -481,7 +488,138 @@ void MemoryFree(void *ptr)
     );
 }
 
+uint64_t platformGetTimeMicros(void)
+{
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    if(frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart)*1000000 +
+            ((counter.QuadPart % frequency.QuadPart)*1000000) / frequency.QuadPart);
+}
+
 uint64_t GetTimeMilis(void)
 {
-    return 0;
+    return platformGetTimeMicros()/1000;
+}
+
+bool platformMakeDirectory(const char *directoryPath)
+{
+    if(CreateDirectoryA(directoryPath, NULL)) return true;
+    return GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+// File watching is not implemented on Windows yet, shaders are not hot reloaded there
+int platformWatchFile(const char *filePath)
+{
+    (void)filePath;
+    return -1;
+}
+
+bool platformPollFileChange(int *watch, char *fileName, size_t fileNameSize)
+{
+    (void)watch;
+    (void)fileName;
+    (void)fileNameSize;
+    return false;
+}
+
+void platformDeinitFileWatcher(void)
+{
+}
+
+typedef struct _PlatformWorkers {
+    bool initialized;
+    bool shouldQuit;
+    HANDLE threads[MAXIMUM_WORKER_THREADS];
+    uint32_t threadCount;
+    SRWLOCK lock;
+    CONDITION_VARIABLE jobAvailable;
+    struct {
+        _WorkerJobFunc func;
+        void *userData;
+    } jobs[MAXIMUM_WORKER_JOBS];
+    uint32_t jobHead, jobCount;
+} _PlatformWorkers;
+
+static _PlatformWorkers WORKERS = {0};
+
+static DWORD WINAPI workerThreadMain(LPVOID arg)
+{
+    (void)arg;
+    for(;;) {
+        AcquireSRWLockExclusive(&WORKERS.lock);
+        while(WORKERS.jobCount == 0 && !WORKERS.shouldQuit)
+            SleepConditionVariableSRW(&WORKERS.jobAvailable, &WORKERS.lock, INFINITE, 0);
+        if(WORKERS.shouldQuit) {
+            ReleaseSRWLockExclusive(&WORKERS.lock);
+            return 0;
+        }
+        _WorkerJobFunc func = WORKERS.jobs[WORKERS.jobHead].func;
+        void *userData = WORKERS.jobs[WORKERS.jobHead].userData;
+        WORKERS.jobHead = (WORKERS.jobHead + 1) % MAXIMUM_WORKER_JOBS;
+        WORKERS.jobCount -= 1;
+        ReleaseSRWLockExclusive(&WORKERS.lock);
+
+        func(userData);
+    }
+}
+
+bool platformInitWorkers(uint32_t workerCount)
+{
+    if(WORKERS.initialized) return true;
+    if(workerCount > MAXIMUM_WORKER_THREADS) workerCount = MAXIMUM_WORKER_THREADS;
+
+    InitializeSRWLock(&WORKERS.lock);
+    InitializeConditionVariable(&WORKERS.jobAvailable);
+    WORKERS.shouldQuit = false;
+    WORKERS.jobHead = 0;
+    WORKERS.jobCount = 0;
+    WORKERS.threadCount = 0;
+    for(uint32_t i = 0; i < workerCount; ++i) {
+        WORKERS.threads[i] = CreateThread(NULL, 0, workerThreadMain, NULL, 0, NULL);
+        if(INV_HANDLE(WORKERS.threads[i])) {
+            TRACELOG(LOG_WARNING, "Failed to create worker thread %u", i);
+            break;
+        }
+        WORKERS.threadCount += 1;
+    }
+    WORKERS.initialized = true;
+    TRACELOG(LOG_INFO, "Started %u worker threads", WORKERS.threadCount);
+    return WORKERS.threadCount > 0;
+}
+
+void platformDeinitWorkers(void)
+{
+    if(!WORKERS.initialized) return;
+    AcquireSRWLockExclusive(&WORKERS.lock);
+    WORKERS.shouldQuit = true;
+    WakeAllConditionVariable(&WORKERS.jobAvailable);
+    ReleaseSRWLockExclusive(&WORKERS.lock);
+    WaitForMultipleObjects(WORKERS.threadCount, WORKERS.threads, TRUE, INFINITE);
+    for(uint32_t i = 0; i < WORKERS.threadCount; ++i)
+        CloseHandle(WORKERS.threads[i]);
+    WORKERS.initialized = false;
+}
+
+bool platformSubmitJob(_WorkerJobFunc func, void *userData)
+{
+    if(!WORKERS.initialized || WORKERS.threadCount == 0) return false;
+    AcquireSRWLockExclusive(&WORKERS.lock);
+    if(WORKERS.jobCount == MAXIMUM_WORKER_JOBS) {
+        ReleaseSRWLockExclusive(&WORKERS.lock);
+        return false;
+    }
+    uint32_t index = (WORKERS.jobHead + WORKERS.jobCount) % MAXIMUM_WORKER_JOBS;
+    WORKERS.jobs[index].func = func;
+    WORKERS.jobs[index].userData = userData;
+    WORKERS.jobCount += 1;
+    WakeConditionVariable(&WORKERS.jobAvailable);
+    ReleaseSRWLockExclusive(&WORKERS.lock);
+    return true;
+}
+
+void platformYieldThread(void)
+{
+    SwitchToThread();
 }
@@ -0,0 +1,197 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#ifndef MAXIMUM_SHADER_CACHE_PATH
+    #define MAXIMUM_SHADER_CACHE_PATH 260
+#endif
+
+#define PROGRAM_BINARY_MAGIC 0x50454f4e // "NOEP"
+#define PROGRAM_BINARY_VERSION 1
+
+/**
+ * Header of a cached program file, followed by `length` bytes of driver binary.
+ * The hash covers both sources and the OpenGL vendor, renderer and version strings,
+ * so a driver update or another GPU never sees a binary it did not produce.
+ */
+typedef struct _ProgramBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash;
+    uint32_t binaryFormat;
+    uint32_t length;
+} _ProgramBinaryHeader;
+
+static struct {
+    char directory[MAXIMUM_SHADER_CACHE_PATH];
+    bool enabled;
+    bool checkedSupport, supported;
+    uint64_t driverHash; // Hash of the driver strings every program hash starts from
+    ShaderCacheStats stats;
+} PROGRAMS = {0};
+
+// FNV-1a, 64 bits so ~60 programs never collide in practice
+static uint64_t hashString(uint64_t hash, const char *string)
+{
+    if(!string) return hash;
+    for(; *string; ++string) {
+        hash ^= (uint8_t)*string;
+        hash *= 1099511628211ull;
+    }
+    // Separator so ("ab", "c") and ("a", "bc") differ
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+static bool isProgramCacheUsable(void)
+{
+    if(!PROGRAMS.enabled) return false;
+    if(!PROGRAMS.checkedSupport) {
+        int formatCount = 0;
+        if(glGetProgramBinary && glProgramBinary) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        PROGRAMS.supported = formatCount > 0;
+        PROGRAMS.checkedSupport = true;
+        if(!PROGRAMS.supported) TRACELOG(LOG_WARNING, "OpenGL driver has no program binary formats, shader cache is disabled");
+
+        uint64_t hash = 14695981039346656037ull;
+        hash = hashString(hash, (const char *)glGetString(GL_VENDOR));
+        hash = hashString(hash, (const char *)glGetString(GL_RENDERER));
+        hash = hashString(hash, (const char *)glGetString(GL_VERSION));
+        PROGRAMS.driverHash = hash;
+    }
+    return PROGRAMS.supported;
+}
+
+// `<directory>/<hash as 16 hex digits>.bin`
+static bool makeProgramPath(char *path, uint64_t hash)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    size_t length = StringLength(PROGRAMS.directory) - 1;
+    if(length + 1 + 16 + 4 + 1 > MAXIMUM_SHADER_CACHE_PATH) return false;
+    MemoryCopy(path, PROGRAMS.directory, length);
+    path[length++] = '/';
+    for(int i = 15; i >= 0; --i) path[length++] = hexDigits[(hash >> (i*4)) & 0xf];
+    MemoryCopy(&path[length], ".bin", 5);
+    return true;
+}
+
+/**
+ * Store compiled programs in `directoryPath` and link later loads of the same sources from there.
+ * The directory is created when missing, NULL turns the cache off.
+ */
+bool SetShaderCacheDirectory(const char *directoryPath)
+{
+    PROGRAMS.enabled = false;
+    if(!directoryPath) return true;
+
+    size_t size = StringLength(directoryPath);
+    if(size > MAXIMUM_SHADER_CACHE_PATH - 22) { // Room for the file name
+        TRACELOG(LOG_ERROR, "Shader cache directory path is too long \"%s\"", directoryPath);
+        return false;
+    }
+    if(!platformMakeDirectory(directoryPath)) {
+        TRACELOG(LOG_ERROR, "Failed to create shader cache directory \"%s\"", directoryPath);
+        return false;
+    }
+    MemoryCopy(PROGRAMS.directory, directoryPath, size);
+    // Trailing separators would double up in file paths
+    while(size > 2 && (PROGRAMS.directory[size - 2] == '/' || PROGRAMS.directory[size - 2] == '\\')) {
+        PROGRAMS.directory[size - 2] = '\0';
+        size -= 1;
+    }
+    PROGRAMS.enabled = true;
+    return true;
+}
+
+ShaderCacheStats GetShaderCacheStats(void)
+{
+    return PROGRAMS.stats;
+}
+
+/**
+ * Link `programID` from a cached binary of these sources, false on a miss or when the driver
+ * rejects the binary (after an update for example), the caller compiles the sources then
+ */
+bool programCacheLoad(uint32_t *programID, const char *vertSource, const char *fragSource)
+{
+    if(!isProgramCacheUsable()) return false;
+    uint64_t hash = hashString(hashString(PROGRAMS.driverHash, vertSource), fragSource);
+    char path[MAXIMUM_SHADER_CACHE_PATH];
+    if(!makeProgramPath(path, hash)) return false;
+
+    size_t fileSize = 0;
+    uint8_t *fileData = LoadFileData(path, &fileSize);
+    if(!fileData) {
+        PROGRAMS.stats.misses += 1;
+        return false;
+    }
+
+    _ProgramBinaryHeader header;
+    bool valid = fileSize >= sizeof(header);
+    if(valid) {
+        MemoryCopy(&header, fileData, sizeof(header));
+        valid = header.magic == PROGRAM_BINARY_MAGIC && header.version == PROGRAM_BINARY_VERSION &&
+            header.hash == hash && header.length == fileSize - sizeof(header);
+    }
+
+    uint32_t program = 0;
+    if(valid) {
+        program = glCreateProgram();
+        glProgramBinary(program, header.binaryFormat, fileData + sizeof(header), header.length);
+        int success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        valid = success != 0;
+        if(!valid) glDeleteProgram(program);
+    }
+    MemoryFree(fileData);
+
+    if(!valid) {
+        PROGRAMS.stats.rejected += 1;
+        TRACELOG(LOG_WARNING, "Cached shader program \"%s\" is stale, compiling it again", path);
+        return false;
+    }
+    PROGRAMS.stats.hits += 1;
+    *programID = program;
+    return true;
+}
+
+// Call before linking so the driver keeps the binary around for `programCacheStore()`
+void programCachePrepare(uint32_t programID)
+{
+    if(!isProgramCacheUsable()) return;
+    glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void programCacheStore(uint32_t programID, const char *vertSource, const char *fragSource)
+{
+    if(!isProgramCacheUsable()) return;
+    uint64_t hash = hashString(hashString(PROGRAMS.driverHash, vertSource), fragSource);
+    char path[MAXIMUM_SHADER_CACHE_PATH];
+    if(!makeProgramPath(path, hash)) return;
+
+    int length = 0;
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0) return;
+
+    size_t fileSize = sizeof(_ProgramBinaryHeader) + (size_t)length;
+    uint8_t *fileData = MemoryAlloc(fileSize);
+    if(!fileData) return;
+    _ProgramBinaryHeader header = {
+        .magic = PROGRAM_BINARY_MAGIC,
+        .version = PROGRAM_BINARY_VERSION,
+        .hash = hash,
+    };
+    int written = 0;
+    glGetProgramBinary(programID, length, &written, &header.binaryFormat, fileData + sizeof(header));
+    header.length = (uint32_t)written;
+    MemoryCopy(fileData, &header, sizeof(header));
+
+    if(written > 0 && SaveFileData(path, fileData, sizeof(header) + (size_t)written)) {
+        PROGRAMS.stats.stored += 1;
+    } else {
+        TRACELOG(LOG_WARNING, "Failed to store shader program \"%s\"", path);
+    }
+    MemoryFree(fileData);
+}
@@ -0,0 +1,117 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#ifndef READBACK_BUFFER_COUNT
+    #define READBACK_BUFFER_COUNT 4 // Readbacks in flight, about the frames of latency before a callback
+#endif
+
+/**
+ * Pixel pack buffer `glReadPixels()` copies into without waiting,
+ * the fence is signaled once the copy is done and the buffer can be mapped
+ */
+typedef struct _ReadbackRequest {
+    uint32_t bufferID;
+    size_t capacity;
+    GLsync fence;
+    uint32_t width, height;
+    ReadbackCallback callback;
+    void *userData;
+} _ReadbackRequest;
+
+static struct {
+    _ReadbackRequest requests[READBACK_BUFFER_COUNT];
+    uint32_t first; // Oldest request in flight
+    uint32_t count;
+    uint32_t stalls; // Requests that had to wait for an older one to free its buffer
+} READBACK = {0};
+
+// Map the pixels of the oldest request, hand them to its callback and free its buffer for reuse
+static void completeOldestReadback(bool wait)
+{
+    _ReadbackRequest *request = &READBACK.requests[READBACK.first];
+    if(wait) glClientWaitSync(request->fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+    glDeleteSync(request->fence);
+    request->fence = NULL;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, request->bufferID);
+    size_t size = (size_t)request->width*request->height*4;
+    const uint8_t *pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if(pixels) {
+        request->callback(pixels, request->width, request->height, request->userData);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        TRACELOG(LOG_ERROR, "Failed to map readback buffer %u", request->bufferID);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    READBACK.first = (READBACK.first + 1) % READBACK_BUFFER_COUNT;
+    READBACK.count -= 1;
+}
+
+/**
+ * Copy a region of the current render target (the window or a render texture in `BeginTextureMode()`)
+ * without stalling. `callback` gets the RGBA8 pixels, rows bottom up like `glReadPixels()`,
+ * from a later `BeginDrawing()` once the GPU is done; the pointer is only valid during the call.
+ * When every buffer is in flight the oldest readback is waited for, so no request is ever dropped.
+ */
+bool ReadPixelsAsync(int x, int y, uint32_t width, uint32_t height, ReadbackCallback callback, void *userData)
+{
+    if(!callback) return false;
+    if(width == 0 || height == 0) return false;
+
+    renderFlushBatch();
+    if(READBACK.count == READBACK_BUFFER_COUNT) {
+        READBACK.stalls += 1;
+        completeOldestReadback(true);
+    }
+
+    _ReadbackRequest *request = &READBACK.requests[(READBACK.first + READBACK.count) % READBACK_BUFFER_COUNT];
+    size_t size = (size_t)width*height*4;
+    if(!request->bufferID) glGenBuffers(1, &request->bufferID);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, request->bufferID);
+    if(request->capacity < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        request->capacity = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void *)0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    request->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    request->width = width;
+    request->height = height;
+    request->callback = callback;
+    request->userData = userData;
+    READBACK.count += 1;
+    return true;
+}
+
+// Wait for every readback in flight and run their callbacks
+void FlushReadbacks(void)
+{
+    while(READBACK.count > 0) completeOldestReadback(true);
+}
+
+// Run the callbacks of finished readbacks in the order they were requested
+void updateAsyncReadbacks(void)
+{
+    while(READBACK.count > 0) {
+        _ReadbackRequest *request = &READBACK.requests[READBACK.first];
+        // The flush bit makes sure the fence reaches the GPU, otherwise it could never signal
+        uint32_t status = glClientWaitSync(request->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if(status == GL_TIMEOUT_EXPIRED) break;
+        completeOldestReadback(false);
+    }
+}
+
+void deinitReadbacks(void)
+{
+    FlushReadbacks();
+    for(uint32_t i = 0; i < READBACK_BUFFER_COUNT; ++i) {
+        if(READBACK.requests[i].bufferID) glDeleteBuffers(1, &READBACK.requests[i].bufferID);
+    }
+    if(READBACK.stalls > 0) TRACELOG(LOG_INFO, "Readbacks waited on the GPU %u times", READBACK.stalls);
+    MemorySet(&READBACK, 0, sizeof(READBACK));
+}
@@ -0,0 +1,207 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+#ifndef MAXIMUM_RENDER_TEXTURES
+    #define MAXIMUM_RENDER_TEXTURES 32
+#endif
+#ifndef RENDER_TEXTURE_IDLE_FRAMES
+    #define RENDER_TEXTURE_IDLE_FRAMES 120 // Frames a released render texture stays pooled before it is deleted
+#endif
+
+/**
+ * Framebuffer with its attachments, released render textures stay here
+ * so the next load with the same size and format reuses them as they are
+ */
+typedef struct _PooledRenderTexture {
+    RenderTexture target;
+    bool inUse;
+    uint32_t idleFrames;
+} _PooledRenderTexture;
+
+static struct {
+    _PooledRenderTexture textures[MAXIMUM_RENDER_TEXTURES];
+    uint32_t created, reused;
+    bool active; // Between `BeginTextureMode()` and `EndTextureMode()`
+    int previousFramebuffer; // Usually the window, restored by `EndTextureMode()`
+    int previousViewport[4];
+} TARGETS = {0};
+
+static void deleteRenderTexture(_PooledRenderTexture *pooled)
+{
+    RenderTexture *target = &pooled->target;
+    glDeleteFramebuffers(1, &target->ID);
+    glDeleteTextures(1, &target->texture.ID);
+    if(target->depthID) glDeleteRenderbuffers(1, &target->depthID);
+    MemorySet(pooled, 0, sizeof(*pooled));
+}
+
+static bool createRenderTexture(RenderTexture *target, uint32_t width, uint32_t height, int format, bool depth)
+{
+    uint32_t compAmount = (uint32_t)format; // R8 = 1, RG8 = 2, RGB8 = 3, RGBA8 = 4
+    MemorySet(target, 0, sizeof(*target));
+    glGenTextures(1, &target->texture.ID);
+    glBindTexture(GL_TEXTURE_2D, target->texture.ID);
+    renderTextureImage(0, NULL, width, height, compAmount);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    renderSetTextureInfo(&target->texture, width, height, compAmount);
+    target->texture.mipmaps = 1;
+    target->texture.memorySize = GetPixelDataSize(width, height, format == PIXEL_FORMAT_RGB8 ? PIXEL_FORMAT_RGBA8 : format);
+    SetTextureSampler(&target->texture, TEXTURE_FILTER_BILINEAR, TEXTURE_WRAP_CLAMP);
+
+    if(depth) {
+        glGenRenderbuffers(1, &target->depthID);
+        glBindRenderbuffer(GL_RENDERBUFFER, target->depthID);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    }
+
+    int boundFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFramebuffer);
+    glGenFramebuffers(1, &target->ID);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->ID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->texture.ID, 0);
+    if(depth) glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target->depthID);
+    uint32_t status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer);
+    if(status != GL_FRAMEBUFFER_COMPLETE) {
+        TRACELOG(LOG_ERROR, "Render texture %ux%u is incomplete (status 0x%x)", width, height, status);
+        glDeleteFramebuffers(1, &target->ID);
+        glDeleteTextures(1, &target->texture.ID);
+        if(target->depthID) glDeleteRenderbuffers(1, &target->depthID);
+        MemorySet(target, 0, sizeof(*target));
+        return false;
+    }
+    return true;
+}
+
+bool LoadRenderTexture(RenderTexture *target, uint32_t width, uint32_t height)
+{
+    return LoadRenderTextureEx(target, width, height, PIXEL_FORMAT_RGBA8, false);
+}
+
+/**
+ * Take a render texture from the pool, one is only created when no released render texture
+ * has the same size, format and depth attachment. The contents of a reused one are undefined.
+ */
+bool LoadRenderTextureEx(RenderTexture *target, uint32_t width, uint32_t height, int format, bool depth)
+{
+    if(!target) return false;
+    if(width == 0 || height == 0) return false;
+    if(format == PIXEL_FORMAT_INVALID) format = PIXEL_FORMAT_RGBA8;
+    if(format > PIXEL_FORMAT_RGBA8) {
+        TRACELOG(LOG_ERROR, "Render textures only support uncompressed pixel formats");
+        return false;
+    }
+
+    _PooledRenderTexture *empty = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES; ++i) {
+        _PooledRenderTexture *pooled = &TARGETS.textures[i];
+        if(pooled->target.ID == 0) {
+            if(!empty) empty = pooled;
+            continue;
+        }
+        if(pooled->inUse) continue;
+        const Texture *texture = &pooled->target.texture;
+        if(texture->width != width || texture->height != height || texture->format != format) continue;
+        if((pooled->target.depthID != 0) != depth) continue;
+
+        pooled->inUse = true;
+        pooled->idleFrames = 0;
+        *target = pooled->target;
+        TARGETS.reused += 1;
+        return true;
+    }
+
+    if(!empty) {
+        // Make room by dropping a released render texture of another size
+        for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES && !empty; ++i) {
+            if(!TARGETS.textures[i].inUse) {
+                deleteRenderTexture(&TARGETS.textures[i]);
+                empty = &TARGETS.textures[i];
+            }
+        }
+    }
+    if(!empty) {
+        TRACELOG(LOG_ERROR, "Too many render textures in use (%d)", MAXIMUM_RENDER_TEXTURES);
+        return false;
+    }
+
+    if(!createRenderTexture(&empty->target, width, height, format, depth)) return false;
+    empty->inUse = true;
+    empty->idleFrames = 0;
+    *target = empty->target;
+    TARGETS.created += 1;
+    TRACELOG(LOG_INFO, "Created render texture with id %u (%ux%u%s)", target->ID, width, height, depth ? ", depth" : "");
+    return true;
+}
+
+// Give the render texture back to the pool, its objects are deleted after `RENDER_TEXTURE_IDLE_FRAMES` unused frames
+void UnloadRenderTexture(RenderTexture target)
+{
+    for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES; ++i) {
+        _PooledRenderTexture *pooled = &TARGETS.textures[i];
+        if(pooled->target.ID == target.ID && pooled->target.ID != 0) {
+            pooled->inUse = false;
+            pooled->idleFrames = 0;
+            return;
+        }
+    }
+}
+
+void TrimRenderTexturePool(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES; ++i) {
+        _PooledRenderTexture *pooled = &TARGETS.textures[i];
+        if(pooled->target.ID != 0 && !pooled->inUse) deleteRenderTexture(pooled);
+    }
+}
+
+/**
+ * Redirect the batch renderer into `target`, the pending batch is drawn into the previous target first.
+ * The viewport, the culling of `BeginMode2D()` and the projection of the default shader cover the render texture,
+ * other shaders keep the projection the caller gave them. `u_View` is flipped so the texture draws upright.
+ */
+void BeginTextureMode(RenderTexture target)
+{
+    renderFlushBatch();
+    if(!TARGETS.active) {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &TARGETS.previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, TARGETS.previousViewport);
+    }
+    TARGETS.active = true;
+    glBindFramebuffer(GL_FRAMEBUFFER, target.ID);
+    glViewport(0, 0, target.texture.width, target.texture.height);
+    renderSetTargetSize(target.texture.width, target.texture.height);
+}
+
+void EndTextureMode(void)
+{
+    if(!TARGETS.active) return;
+    renderFlushBatch();
+    TARGETS.active = false;
+    renderSetTargetSize(0, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, TARGETS.previousFramebuffer);
+    glViewport(TARGETS.previousViewport[0], TARGETS.previousViewport[1],
+            TARGETS.previousViewport[2], TARGETS.previousViewport[3]);
+}
+
+void updateRenderTexturePool(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES; ++i) {
+        _PooledRenderTexture *pooled = &TARGETS.textures[i];
+        if(pooled->target.ID == 0 || pooled->inUse) continue;
+        pooled->idleFrames += 1;
+        if(pooled->idleFrames > RENDER_TEXTURE_IDLE_FRAMES) deleteRenderTexture(pooled);
+    }
+}
+
+void deinitRenderTexturePool(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_RENDER_TEXTURES; ++i) {
+        if(TARGETS.textures[i].target.ID != 0) deleteRenderTexture(&TARGETS.textures[i]);
+    }
+    if(TARGETS.created > 0) TRACELOG(LOG_INFO, "Render texture pool: %u created, %u reused", TARGETS.created, TARGETS.reused);
+}
@@ -0,0 +1,292 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+#include <math.h>
+
+#ifndef MAXIMUM_STREAMED_TEXTURES
+    #define MAXIMUM_STREAMED_TEXTURES 512
+#endif
+#ifndef MAXIMUM_STREAMED_MIPMAPS
+    #define MAXIMUM_STREAMED_MIPMAPS 16
+#endif
+#ifndef STREAMED_TEXTURE_TAIL_SIZE
+    #define STREAMED_TEXTURE_TAIL_SIZE 64 // Largest side of the mip tail that always stays resident
+#endif
+#ifndef STREAMED_TEXTURE_IDLE_FRAMES
+    #define STREAMED_TEXTURE_IDLE_FRAMES 120 // Frames without a draw before a texture falls back to its tail
+#endif
+#ifndef STREAMED_TEXTURE_UPLOADS_PER_FRAME
+    #define STREAMED_TEXTURE_UPLOADS_PER_FRAME 4
+#endif
+#ifndef DEFAULT_TEXTURE_MEMORY_BUDGET
+    #define DEFAULT_TEXTURE_MEMORY_BUDGET (256*1024*1024)
+#endif
+
+// Open addressing table from texture ID to streamed texture, twice as large as the texture count
+#define STREAMED_TEXTURE_TABLE_SIZE (2*MAXIMUM_STREAMED_TEXTURES)
+
+typedef struct _StreamedTexture {
+    uint32_t textureID;
+    uint32_t width, height, compAmount;
+    uint32_t mipmapCount;
+    uint8_t *levels[MAXIMUM_STREAMED_MIPMAPS]; // Full mip chain kept in system memory
+    uint32_t residentLevel; // Largest mipmap level uploaded to the GPU
+    uint32_t tailLevel; // Smallest level that is always resident
+    uint32_t wantedLevel;
+
+    float drawnSize; // Largest on-screen side drawn since the last update
+    float lastDrawnSize; // Kept while the texture is skipped for less than `STREAMED_TEXTURE_IDLE_FRAMES`
+    uint64_t lastDrawnFrame;
+} _StreamedTexture;
+
+static struct {
+    _StreamedTexture textures[MAXIMUM_STREAMED_TEXTURES];
+    uint32_t count;
+    int16_t table[STREAMED_TEXTURE_TABLE_SIZE]; // Index + 1 into `textures`, 0 is empty
+    size_t budget;
+    size_t residentMemory;
+    uint64_t frame;
+} RESIDENCY = {
+    .budget = DEFAULT_TEXTURE_MEMORY_BUDGET,
+};
+
+static inline uint32_t levelSize(uint32_t size, uint32_t level)
+{
+    size >>= level;
+    return size > 0 ? size : 1;
+}
+
+// GPU memory of the levels from `level` to the end of the chain, RGB is stored as RGBA
+static size_t streamedMemorySize(const _StreamedTexture *streamed, uint32_t level)
+{
+    uint32_t bytes = streamed->compAmount == 3 ? 4 : streamed->compAmount;
+    size_t result = 0;
+    for(uint32_t i = level; i < streamed->mipmapCount; ++i)
+        result += (size_t)levelSize(streamed->width, i)*levelSize(streamed->height, i)*bytes;
+    return result;
+}
+
+static _StreamedTexture *findStreamedTexture(uint32_t textureID)
+{
+    uint32_t slot = (textureID*2654435761u) % STREAMED_TEXTURE_TABLE_SIZE;
+    for(uint32_t probe = 0; probe < STREAMED_TEXTURE_TABLE_SIZE; ++probe) {
+        int16_t index = RESIDENCY.table[slot];
+        if(index == 0) return NULL;
+        if(index > 0 && RESIDENCY.textures[index - 1].textureID == textureID) return &RESIDENCY.textures[index - 1];
+        slot = (slot + 1) % STREAMED_TEXTURE_TABLE_SIZE;
+    }
+    return NULL;
+}
+
+// Table indices are rebuilt from scratch, removal swaps the last texture into the hole
+static void rebuildStreamedTable(void)
+{
+    MemorySet(RESIDENCY.table, 0, sizeof(RESIDENCY.table));
+    for(uint32_t i = 0; i < RESIDENCY.count; ++i) {
+        uint32_t slot = (RESIDENCY.textures[i].textureID*2654435761u) % STREAMED_TEXTURE_TABLE_SIZE;
+        while(RESIDENCY.table[slot] != 0) slot = (slot + 1) % STREAMED_TEXTURE_TABLE_SIZE;
+        RESIDENCY.table[slot] = (int16_t)(i + 1);
+    }
+}
+
+// 2x2 box filter, odd sizes repeat their last row or column
+static void downsampleLevel(uint8_t *dst, const uint8_t *src, uint32_t srcWidth, uint32_t srcHeight, uint32_t compAmount)
+{
+    uint32_t dstWidth = srcWidth > 1 ? srcWidth/2 : 1;
+    uint32_t dstHeight = srcHeight > 1 ? srcHeight/2 : 1;
+    for(uint32_t y = 0; y < dstHeight; ++y) {
+        uint32_t y0 = 2*y < srcHeight ? 2*y : srcHeight - 1;
+        uint32_t y1 = 2*y + 1 < srcHeight ? 2*y + 1 : y0;
+        for(uint32_t x = 0; x < dstWidth; ++x) {
+            uint32_t x0 = 2*x < srcWidth ? 2*x : srcWidth - 1;
+            uint32_t x1 = 2*x + 1 < srcWidth ? 2*x + 1 : x0;
+            for(uint32_t c = 0; c < compAmount; ++c) {
+                uint32_t sum = src[(y0*srcWidth + x0)*compAmount + c] + src[(y0*srcWidth + x1)*compAmount + c] +
+                    src[(y1*srcWidth + x0)*compAmount + c] + src[(y1*srcWidth + x1)*compAmount + c];
+                dst[(y*dstWidth + x)*compAmount + c] = (uint8_t)((sum + 2)/4);
+            }
+        }
+    }
+}
+
+// Respecify the GPU texture so it only holds `level` and the smaller mipmaps
+static void uploadResidentLevels(_StreamedTexture *streamed, uint32_t level)
+{
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, streamed->textureID);
+    for(uint32_t i = level; i < streamed->mipmapCount; ++i) {
+        renderTextureImage(i - level, streamed->levels[i], levelSize(streamed->width, i), levelSize(streamed->height, i),
+                streamed->compAmount);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, streamed->mipmapCount - level - 1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    RESIDENCY.residentMemory -= streamedMemorySize(streamed, streamed->residentLevel);
+    RESIDENCY.residentMemory += streamedMemorySize(streamed, level);
+    streamed->residentLevel = level;
+}
+
+/**
+ * Load a texture whose mipmaps are streamed in and out of GPU memory by the size it is drawn at.
+ * The pixels are copied and a full mip chain is kept in system memory, only the mip tail is uploaded
+ * at first and `BeginDrawing()` uploads sharper levels while the texture is drawn larger,
+ * within the budget set by `SetTextureMemoryBudget()`.
+ */
+bool LoadTextureStreamed(Texture *texture, const uint8_t *data, uint32_t width, uint32_t height, uint32_t compAmount)
+{
+    if(!texture) return false;
+    if(!data) return false;
+    if(compAmount == 0 || compAmount > 4 || width == 0 || height == 0) return false;
+    if(RESIDENCY.count == MAXIMUM_STREAMED_TEXTURES) {
+        TRACELOG(LOG_WARNING, "Too many streamed textures, loading a regular texture instead");
+        return LoadTexture(texture, data, width, height, compAmount);
+    }
+
+    _StreamedTexture streamed = {
+        .width = width,
+        .height = height,
+        .compAmount = compAmount,
+        .mipmapCount = 1,
+    };
+    for(uint32_t size = width > height ? width : height; size > 1 && streamed.mipmapCount < MAXIMUM_STREAMED_MIPMAPS; size /= 2)
+        streamed.mipmapCount += 1;
+
+    bool tailFound = false;
+    for(uint32_t i = 0; i < streamed.mipmapCount; ++i) {
+        uint32_t levelWidth = levelSize(width, i), levelHeight = levelSize(height, i);
+        streamed.levels[i] = MemoryAlloc((size_t)levelWidth*levelHeight*compAmount);
+        if(!streamed.levels[i]) {
+            for(uint32_t j = 0; j < i; ++j) MemoryFree(streamed.levels[j]);
+            return false;
+        }
+        if(i == 0) MemoryCopy(streamed.levels[0], data, (size_t)width*height*compAmount);
+        else downsampleLevel(streamed.levels[i], streamed.levels[i - 1], levelSize(width, i - 1), levelSize(height, i - 1), compAmount);
+
+        if(!tailFound && levelWidth <= STREAMED_TEXTURE_TAIL_SIZE && levelHeight <= STREAMED_TEXTURE_TAIL_SIZE) {
+            streamed.tailLevel = i;
+            tailFound = true;
+        }
+    }
+    if(!tailFound) streamed.tailLevel = streamed.mipmapCount - 1;
+    streamed.residentLevel = streamed.mipmapCount; // Nothing resident yet
+    streamed.wantedLevel = streamed.tailLevel;
+
+    glGenTextures(1, &streamed.textureID);
+    glBindTexture(GL_TEXTURE_2D, streamed.textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    _StreamedTexture *result = &RESIDENCY.textures[RESIDENCY.count++];
+    *result = streamed;
+    uploadResidentLevels(result, result->tailLevel);
+    rebuildStreamedTable();
+
+    renderSetTextureInfo(texture, width, height, compAmount);
+    texture->ID = result->textureID;
+    texture->samplerID = 0;
+    texture->memorySize = streamedMemorySize(result, result->residentLevel);
+    TRACELOG(LOG_INFO, "Loaded streamed texture with id %u (%u mipmaps, tail level %u)",
+            texture->ID, result->mipmapCount, result->tailLevel);
+    return true;
+}
+
+void SetTextureMemoryBudget(size_t bytes)
+{
+    RESIDENCY.budget = bytes;
+}
+
+size_t GetTextureMemoryUsage(void)
+{
+    return RESIDENCY.residentMemory;
+}
+
+uint32_t GetTextureResidentLevel(Texture texture)
+{
+    _StreamedTexture *streamed = findStreamedTexture(texture.ID);
+    return streamed ? streamed->residentLevel : 0;
+}
+
+void residencyTrackTexture(Texture texture, float screenWidth, float screenHeight)
+{
+    if(RESIDENCY.count == 0) return;
+    _StreamedTexture *streamed = findStreamedTexture(texture.ID);
+    if(!streamed) return;
+
+    float scale = renderGetViewScale();
+    float size = fmaxf(fabsf(screenWidth), fabsf(screenHeight))*scale;
+    if(size > streamed->drawnSize) streamed->drawnSize = size;
+    streamed->lastDrawnFrame = RESIDENCY.frame;
+}
+
+void residencyForgetTexture(uint32_t textureID)
+{
+    _StreamedTexture *streamed = findStreamedTexture(textureID);
+    if(!streamed) return;
+
+    RESIDENCY.residentMemory -= streamedMemorySize(streamed, streamed->residentLevel);
+    for(uint32_t i = 0; i < streamed->mipmapCount; ++i) MemoryFree(streamed->levels[i]);
+    *streamed = RESIDENCY.textures[--RESIDENCY.count];
+    rebuildStreamedTable();
+}
+
+// Pick the mipmap level matching the drawn size of every texture, then shrink the sharpest ones until the budget fits
+void updateTextureResidency(void)
+{
+    if(RESIDENCY.count == 0) return;
+    size_t total = 0;
+    for(uint32_t i = 0; i < RESIDENCY.count; ++i) {
+        _StreamedTexture *streamed = &RESIDENCY.textures[i];
+        uint32_t level = streamed->tailLevel;
+        if(streamed->drawnSize > 0.0f) streamed->lastDrawnSize = streamed->drawnSize;
+        bool idle = RESIDENCY.frame - streamed->lastDrawnFrame > STREAMED_TEXTURE_IDLE_FRAMES;
+        if(!idle && streamed->lastDrawnSize > 0.0f) {
+            // Level whose size is still at least as large as the drawn size
+            float fullSize = (float)(streamed->width > streamed->height ? streamed->width : streamed->height);
+            float ratio = fullSize / streamed->lastDrawnSize;
+            level = ratio > 1.0f ? (uint32_t)floorf(log2f(ratio)) : 0;
+            if(level > streamed->tailLevel) level = streamed->tailLevel;
+        }
+        streamed->wantedLevel = level;
+        streamed->drawnSize = 0.0f;
+        total += streamedMemorySize(streamed, level);
+    }
+
+    while(total > RESIDENCY.budget) {
+        _StreamedTexture *largest = NULL;
+        size_t largestSize = 0;
+        for(uint32_t i = 0; i < RESIDENCY.count; ++i) {
+            _StreamedTexture *streamed = &RESIDENCY.textures[i];
+            if(streamed->wantedLevel >= streamed->tailLevel) continue;
+            size_t size = streamedMemorySize(streamed, streamed->wantedLevel);
+            if(size > largestSize) {
+                largest = streamed;
+                largestSize = size;
+            }
+        }
+        if(!largest) break; // Only mip tails are left, they always stay resident
+        largest->wantedLevel += 1;
+        total -= largestSize - streamedMemorySize(largest, largest->wantedLevel);
+    }
+
+    // Evictions go first so memory is freed before sharper levels come in, one level at a time
+    uint32_t uploads = 0;
+    for(uint32_t i = 0; i < RESIDENCY.count && uploads < STREAMED_TEXTURE_UPLOADS_PER_FRAME; ++i) {
+        _StreamedTexture *streamed = &RESIDENCY.textures[i];
+        if(streamed->wantedLevel > streamed->residentLevel) {
+            uploadResidentLevels(streamed, streamed->wantedLevel);
+            uploads += 1;
+        }
+    }
+    for(uint32_t i = 0; i < RESIDENCY.count && uploads < STREAMED_TEXTURE_UPLOADS_PER_FRAME; ++i) {
+        _StreamedTexture *streamed = &RESIDENCY.textures[i];
+        if(streamed->wantedLevel < streamed->residentLevel) {
+            uploadResidentLevels(streamed, streamed->residentLevel - 1);
+            uploads += 1;
+        }
+    }
+    RESIDENCY.frame += 1;
+}
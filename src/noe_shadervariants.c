@@ -0,0 +1,287 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#ifndef MAXIMUM_SHADER_VARIANT_SETS
+    #define MAXIMUM_SHADER_VARIANT_SETS 32
+#endif
+#ifndef MAXIMUM_SHADER_VARIANTS
+    #define MAXIMUM_SHADER_VARIANTS 256 // Power of two, shared by every set
+#endif
+#ifndef MAXIMUM_SHADER_FEATURES
+    #define MAXIMUM_SHADER_FEATURES 32 // Bits of a feature mask
+#endif
+
+/**
+ * Sources and feature names every variant of a set is built from,
+ * loading the same ones again shares the set and its compiled variants
+ */
+typedef struct _ShaderVariantSet {
+    uint64_t hash; // Of both sources and the feature names, 0 for a free set
+    uint32_t refCount;
+    char *vertSource, *fragSource;
+    char *featureNames[MAXIMUM_SHADER_FEATURES];
+    uint32_t featureCount;
+} _ShaderVariantSet;
+
+typedef enum _VariantState {
+    VARIANT_EMPTY = 0,
+    VARIANT_USED,
+    VARIANT_DELETED, // Keeps probing past it, entries never move since `LoadShaderAsync()` holds their shader
+} _VariantState;
+
+typedef struct _ShaderVariant {
+    int state;
+    uint64_t hash;
+    uint32_t mask;
+    Shader shader;
+} _ShaderVariant;
+
+static struct {
+    _ShaderVariantSet sets[MAXIMUM_SHADER_VARIANT_SETS];
+    _ShaderVariant variants[MAXIMUM_SHADER_VARIANTS]; // Open addressing on (set hash, mask)
+    uint32_t variantCount;
+} VARIANTS = {0};
+
+static uint64_t hashVariantString(uint64_t hash, const char *string)
+{
+    for(; *string; ++string) {
+        hash ^= (uint8_t)*string;
+        hash *= 1099511628211ull;
+    }
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+static uint32_t getVariantIndex(uint64_t hash, uint32_t mask)
+{
+    uint64_t key = hash ^ ((uint64_t)mask*0x9e3779b97f4a7c15ull);
+    return (uint32_t)(key ^ (key >> 32)) & (MAXIMUM_SHADER_VARIANTS - 1);
+}
+
+static _ShaderVariant *findVariant(uint64_t hash, uint32_t mask)
+{
+    uint32_t index = getVariantIndex(hash, mask);
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_VARIANTS; ++i) {
+        _ShaderVariant *variant = &VARIANTS.variants[(index + i) & (MAXIMUM_SHADER_VARIANTS - 1)];
+        if(variant->state == VARIANT_EMPTY) return NULL;
+        if(variant->state == VARIANT_USED && variant->hash == hash && variant->mask == mask) return variant;
+    }
+    return NULL;
+}
+
+static _ShaderVariant *insertVariant(uint64_t hash, uint32_t mask)
+{
+    // Keep a quarter free so probes stay short
+    if(VARIANTS.variantCount >= MAXIMUM_SHADER_VARIANTS - MAXIMUM_SHADER_VARIANTS/4) return NULL;
+    uint32_t index = getVariantIndex(hash, mask);
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_VARIANTS; ++i) {
+        _ShaderVariant *variant = &VARIANTS.variants[(index + i) & (MAXIMUM_SHADER_VARIANTS - 1)];
+        if(variant->state == VARIANT_USED) continue;
+        variant->state = VARIANT_USED;
+        variant->hash = hash;
+        variant->mask = mask;
+        variant->shader = CLITERAL(Shader){0};
+        VARIANTS.variantCount += 1;
+        return variant;
+    }
+    return NULL;
+}
+
+static char *copyVariantString(const char *string)
+{
+    size_t size = StringLength(string);
+    char *result = MemoryAlloc(size);
+    if(result) MemoryCopy(result, string, size);
+    return result;
+}
+
+static void freeVariantSet(_ShaderVariantSet *set)
+{
+    MemoryFree(set->vertSource);
+    MemoryFree(set->fragSource);
+    for(uint32_t i = 0; i < set->featureCount; ++i) MemoryFree(set->featureNames[i]);
+    MemorySet(set, 0, sizeof(*set));
+}
+
+static _ShaderVariantSet *getVariantSet(ShaderVariants variants)
+{
+    if(variants.ID == 0 || variants.ID > MAXIMUM_SHADER_VARIANT_SETS) return NULL;
+    _ShaderVariantSet *set = &VARIANTS.sets[variants.ID - 1];
+    return set->hash != 0 ? set : NULL;
+}
+
+/**
+ * `source` with a `#define` for every feature in `mask` after its `#version` line,
+ * followed by a `#line` so compile errors still point at the lines of the file
+ */
+static char *injectFeatureDefines(const _ShaderVariantSet *set, const char *source, uint32_t mask)
+{
+    const char *insertAt = source;
+    uint32_t line = 1;
+    const char *version = StringFind(source, "#version");
+    if(version) {
+        insertAt = version;
+        while(*insertAt && *insertAt != '\n') ++insertAt;
+        if(*insertAt == '\n') ++insertAt;
+        for(const char *p = source; p < insertAt; ++p) {
+            if(*p == '\n') line += 1;
+        }
+    }
+
+    size_t headerSize = 20; // `#line` directive
+    for(uint32_t i = 0; i < set->featureCount; ++i) {
+        if(mask & (1u << i)) headerSize += StringLength(set->featureNames[i]) + 12;
+    }
+    size_t prefixLength = (size_t)(insertAt - source);
+    size_t sourceSize = StringLength(source);
+    char *result = MemoryAlloc(sourceSize + headerSize + 1);
+    if(!result) return NULL;
+
+    size_t length = prefixLength;
+    MemoryCopy(result, source, prefixLength);
+    if(prefixLength > 0 && result[prefixLength - 1] != '\n') result[length++] = '\n';
+    for(uint32_t i = 0; i < set->featureCount; ++i) {
+        if(!(mask & (1u << i))) continue;
+        size_t nameLength = StringLength(set->featureNames[i]) - 1;
+        MemoryCopy(&result[length], "#define ", 8);
+        length += 8;
+        MemoryCopy(&result[length], set->featureNames[i], nameLength);
+        length += nameLength;
+        MemoryCopy(&result[length], " 1\n", 3);
+        length += 3;
+    }
+    MemoryCopy(&result[length], "#line ", 6);
+    length += 6;
+    char digits[10];
+    uint32_t digitCount = 0;
+    do {
+        digits[digitCount++] = (char)('0' + line % 10);
+        line /= 10;
+    } while(line > 0);
+    while(digitCount > 0) result[length++] = digits[--digitCount];
+    result[length++] = '\n';
+    MemoryCopy(&result[length], insertAt, sourceSize - prefixLength);
+    return result;
+}
+
+static _ShaderVariant *compileVariant(const _ShaderVariantSet *set, uint32_t mask)
+{
+    _ShaderVariant *variant = insertVariant(set->hash, mask);
+    if(!variant) {
+        TRACELOG(LOG_ERROR, "Too many shader variants (%d)", MAXIMUM_SHADER_VARIANTS);
+        return NULL;
+    }
+    char *vertSource = injectFeatureDefines(set, set->vertSource, mask);
+    char *fragSource = injectFeatureDefines(set, set->fragSource, mask);
+    if(!vertSource || !fragSource || !LoadShaderAsync(&variant->shader, vertSource, fragSource)) {
+        TRACELOG(LOG_ERROR, "Failed to compile shader variant 0x%x", mask);
+    }
+    MemoryFree(vertSource);
+    MemoryFree(fragSource);
+    // A variant that failed stays in the table with an ID of 0, so it is not compiled again every frame
+    return variant;
+}
+
+/**
+ * Sources every variant is made from, feature `i` of a mask becomes `#define <featureNames[i]> 1`
+ * in both stages. Sets with the same sources and feature names share their compiled variants.
+ */
+bool LoadShaderVariants(ShaderVariants *variants, const char *vertSource, const char *fragSource,
+        const char **featureNames, uint32_t featureCount)
+{
+    if(!variants) return false;
+    if(!vertSource || !fragSource) return false;
+    if(featureCount > MAXIMUM_SHADER_FEATURES) {
+        TRACELOG(LOG_ERROR, "Shader variants support at most %d features", MAXIMUM_SHADER_FEATURES);
+        return false;
+    }
+    variants->ID = 0;
+
+    uint64_t hash = 14695981039346656037ull;
+    hash = hashVariantString(hash, vertSource);
+    hash = hashVariantString(hash, fragSource);
+    for(uint32_t i = 0; i < featureCount; ++i) hash = hashVariantString(hash, featureNames[i]);
+    if(hash == 0) hash = 1;
+
+    _ShaderVariantSet *empty = NULL;
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_VARIANT_SETS; ++i) {
+        _ShaderVariantSet *set = &VARIANTS.sets[i];
+        if(set->hash == hash) {
+            set->refCount += 1;
+            variants->ID = i + 1;
+            return true;
+        }
+        if(set->hash == 0 && !empty) empty = set;
+    }
+    if(!empty) {
+        TRACELOG(LOG_ERROR, "Too many shader variant sets (%d)", MAXIMUM_SHADER_VARIANT_SETS);
+        return false;
+    }
+
+    empty->vertSource = copyVariantString(vertSource);
+    empty->fragSource = copyVariantString(fragSource);
+    bool copied = empty->vertSource && empty->fragSource;
+    for(uint32_t i = 0; i < featureCount; ++i) {
+        empty->featureNames[i] = copyVariantString(featureNames[i]);
+        empty->featureCount += 1;
+        copied = copied && empty->featureNames[i];
+    }
+    if(!copied) {
+        freeVariantSet(empty);
+        return false;
+    }
+    empty->hash = hash;
+    empty->refCount = 1;
+    variants->ID = (uint32_t)(empty - VARIANTS.sets) + 1;
+    return true;
+}
+
+/**
+ * Shader with the features of `featureMask`, the first request of a mask starts compiling it
+ * without waiting, so `RenderFlush()` draws with the fallback shader until it is ready.
+ * Ask again every frame, it is a table lookup once the variant exists.
+ */
+Shader GetShaderVariant(ShaderVariants variants, uint32_t featureMask)
+{
+    _ShaderVariantSet *set = getVariantSet(variants);
+    if(!set) return CLITERAL(Shader){0};
+    if(set->featureCount < 32) featureMask &= (1u << set->featureCount) - 1;
+
+    _ShaderVariant *variant = findVariant(set->hash, featureMask);
+    if(!variant) variant = compileVariant(set, featureMask);
+    return variant ? variant->shader : CLITERAL(Shader){0};
+}
+
+// Start compiling the variants of every mask together, drivers with parallel compiles build them side by side
+void PrecompileShaderVariants(ShaderVariants variants, const uint32_t *featureMasks, uint32_t count)
+{
+    for(uint32_t i = 0; i < count; ++i) GetShaderVariant(variants, featureMasks[i]);
+}
+
+// The compiled variants are deleted with the last set using them
+void UnloadShaderVariants(ShaderVariants variants)
+{
+    _ShaderVariantSet *set = getVariantSet(variants);
+    if(!set) return;
+    set->refCount -= 1;
+    if(set->refCount > 0) return;
+
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_VARIANTS; ++i) {
+        _ShaderVariant *variant = &VARIANTS.variants[i];
+        if(variant->state != VARIANT_USED || variant->hash != set->hash) continue;
+        if(variant->shader.ID != 0) UnloadShader(variant->shader);
+        variant->state = VARIANT_DELETED;
+        VARIANTS.variantCount -= 1;
+    }
+    freeVariantSet(set);
+}
+
+void deinitShaderVariants(void)
+{
+    for(uint32_t i = 0; i < MAXIMUM_SHADER_VARIANT_SETS; ++i) {
+        if(VARIANTS.sets[i].hash != 0) freeVariantSet(&VARIANTS.sets[i]);
+    }
+    // The programs go with the context
+    MemorySet(&VARIANTS, 0, sizeof(VARIANTS));
+}
@@ -0,0 +1,216 @@
+#include "noe.h"
+
+#include <math.h>
+
+#ifndef SDF_DEFAULT_SPREAD
+    #define SDF_DEFAULT_SPREAD 4
+#endif
+#ifndef SDF_COVERAGE_THRESHOLD
+    #define SDF_COVERAGE_THRESHOLD 127
+#endif
+
+#define SDF_FAR_AWAY (1 << 14)
+
+typedef struct _SDFPoint {
+    int dx, dy;
+} _SDFPoint;
+
+static inline int sdfPointDistSqr(_SDFPoint p)
+{
+    return p.dx*p.dx + p.dy*p.dy;
+}
+
+static inline void sdfCompare(_SDFPoint *grid, int width, int height, int x, int y, int offsetX, int offsetY)
+{
+    int ox = x + offsetX;
+    int oy = y + offsetY;
+    if(ox < 0 || oy < 0 || ox >= width || oy >= height) return;
+
+    _SDFPoint other = grid[oy*width + ox];
+    other.dx += offsetX;
+    other.dy += offsetY;
+    if(sdfPointDistSqr(other) < sdfPointDistSqr(grid[y*width + x])) grid[y*width + x] = other;
+}
+
+// 8-points signed sequential euclidean distance transform (8SSEDT)
+static void sdfPropagate(_SDFPoint *grid, int width, int height)
+{
+    for(int y = 0; y < height; ++y) {
+        for(int x = 0; x < width; ++x) {
+            sdfCompare(grid, width, height, x, y, -1,  0);
+            sdfCompare(grid, width, height, x, y,  0, -1);
+            sdfCompare(grid, width, height, x, y, -1, -1);
+            sdfCompare(grid, width, height, x, y,  1, -1);
+        }
+        for(int x = width - 1; x >= 0; --x)
+            sdfCompare(grid, width, height, x, y, 1, 0);
+    }
+
+    for(int y = height - 1; y >= 0; --y) {
+        for(int x = width - 1; x >= 0; --x) {
+            sdfCompare(grid, width, height, x, y,  1,  0);
+            sdfCompare(grid, width, height, x, y,  0,  1);
+            sdfCompare(grid, width, height, x, y, -1,  1);
+            sdfCompare(grid, width, height, x, y,  1,  1);
+        }
+        for(int x = 0; x < width; ++x)
+            sdfCompare(grid, width, height, x, y, -1, 0);
+    }
+}
+
+/**
+ * Convert a high resolution single channel coverage image into a signed distance field that is
+ * `downscale` times smaller. `spread` is the distance (in result pixels) mapped to the [0, 255] range,
+ * 128 lies on the edge and values above it are inside the shape. Free the result with `MemoryFree()`.
+ */
+uint8_t *GenImageSDF(const uint8_t *coverage, uint32_t width, uint32_t height, uint32_t downscale, uint32_t spread,
+        uint32_t *resultWidth, uint32_t *resultHeight)
+{
+    if(!coverage) return NULL;
+    if(downscale == 0) downscale = 1;
+    if(spread == 0) spread = SDF_DEFAULT_SPREAD;
+
+    size_t count = (size_t)width*height;
+    _SDFPoint *outside = MemoryAlloc(sizeof(_SDFPoint) * count);
+    _SDFPoint *inside = MemoryAlloc(sizeof(_SDFPoint) * count);
+    uint32_t sdfWidth = width / downscale;
+    uint32_t sdfHeight = height / downscale;
+    uint8_t *result = MemoryAlloc((size_t)sdfWidth*sdfHeight);
+    if(!outside || !inside || !result) {
+        MemoryFree(outside);
+        MemoryFree(inside);
+        MemoryFree(result);
+        return NULL;
+    }
+
+    const _SDFPoint zero = { 0, 0 };
+    const _SDFPoint farAway = { SDF_FAR_AWAY, SDF_FAR_AWAY };
+    for(size_t i = 0; i < count; ++i) {
+        bool isInside = coverage[i] > SDF_COVERAGE_THRESHOLD;
+        outside[i] = isInside ? zero : farAway;
+        inside[i] = isInside ? farAway : zero;
+    }
+    sdfPropagate(outside, width, height);
+    sdfPropagate(inside, width, height);
+
+    float range = (float)(spread * downscale);
+    for(uint32_t y = 0; y < sdfHeight; ++y) {
+        for(uint32_t x = 0; x < sdfWidth; ++x) {
+            size_t i = (size_t)(y*downscale + downscale/2)*width + (x*downscale + downscale/2);
+            // Positive inside the shape, negative outside
+            float dist = sqrtf((float)sdfPointDistSqr(inside[i])) - sqrtf((float)sdfPointDistSqr(outside[i]));
+            float value = 0.5f + 0.5f*(dist/range);
+            if(value < 0.0f) value = 0.0f;
+            if(value > 1.0f) value = 1.0f;
+            result[y*sdfWidth + x] = (uint8_t)(value*255.0f + 0.5f);
+        }
+    }
+
+    MemoryFree(outside);
+    MemoryFree(inside);
+    if(resultWidth) *resultWidth = sdfWidth;
+    if(resultHeight) *resultHeight = sdfHeight;
+    return result;
+}
+
+/**
+ * Build a distance field font from a single channel glyph sheet rendered at high resolution.
+ * The sheet is a grid of `glyphWidth`x`glyphHeight` cells laid out row by row starting at `firstCodepoint`.
+ * Every glyph is converted once into a `downscale` times smaller distance field atlas that can be drawn
+ * at any size with `DrawText()`.
+ */
+bool LoadFontSDF(Font *font, const uint8_t *glyphSheet, uint32_t sheetWidth, uint32_t sheetHeight,
+        uint32_t glyphWidth, uint32_t glyphHeight, int firstCodepoint, uint32_t downscale)
+{
+    if(!font) return false;
+    if(!glyphSheet) return false;
+    if(glyphWidth == 0 || glyphHeight == 0) return false;
+    if(downscale == 0) downscale = 1;
+
+    uint32_t columns = sheetWidth / glyphWidth;
+    uint32_t rows = sheetHeight / glyphHeight;
+    int glyphCount = (int)(columns*rows);
+    if(glyphCount == 0) return false;
+
+    // Every cell is padded so the distance field has room to fall off around the glyph
+    uint32_t padding = SDF_DEFAULT_SPREAD;
+    uint32_t cellWidth = glyphWidth + 2*padding*downscale;
+    uint32_t cellHeight = glyphHeight + 2*padding*downscale;
+    uint32_t sdfCellWidth = cellWidth / downscale;
+    uint32_t sdfCellHeight = cellHeight / downscale;
+
+    uint32_t atlasColumns = 1;
+    while(atlasColumns*atlasColumns < (uint32_t)glyphCount) atlasColumns += 1;
+    uint32_t atlasRows = (glyphCount + atlasColumns - 1) / atlasColumns;
+    uint32_t atlasWidth = atlasColumns*sdfCellWidth;
+    uint32_t atlasHeight = atlasRows*sdfCellHeight;
+
+    uint8_t *cell = MemoryAlloc((size_t)cellWidth*cellHeight);
+    uint8_t *atlas = MemoryAlloc((size_t)atlasWidth*atlasHeight);
+    GlyphInfo *glyphs = MemoryAlloc(sizeof(GlyphInfo) * glyphCount);
+    if(!cell || !atlas || !glyphs) {
+        MemoryFree(cell);
+        MemoryFree(atlas);
+        MemoryFree(glyphs);
+        return false;
+    }
+    MemorySet(atlas, 0, (size_t)atlasWidth*atlasHeight);
+
+    for(int i = 0; i < glyphCount; ++i) {
+        uint32_t sheetX = (i % columns)*glyphWidth;
+        uint32_t sheetY = (i / columns)*glyphHeight;
+        MemorySet(cell, 0, (size_t)cellWidth*cellHeight);
+        for(uint32_t y = 0; y < glyphHeight; ++y) {
+            MemoryCopy(&cell[(y + padding*downscale)*cellWidth + padding*downscale],
+                    &glyphSheet[(size_t)(sheetY + y)*sheetWidth + sheetX], glyphWidth);
+        }
+
+        uint32_t sdfWidth, sdfHeight;
+        uint8_t *sdf = GenImageSDF(cell, cellWidth, cellHeight, downscale, padding, &sdfWidth, &sdfHeight);
+        if(!sdf) {
+            MemoryFree(cell);
+            MemoryFree(atlas);
+            MemoryFree(glyphs);
+            return false;
+        }
+
+        uint32_t atlasX = (i % atlasColumns)*sdfCellWidth;
+        uint32_t atlasY = (i / atlasColumns)*sdfCellHeight;
+        for(uint32_t y = 0; y < sdfHeight; ++y)
+            MemoryCopy(&atlas[(size_t)(atlasY + y)*atlasWidth + atlasX], &sdf[y*sdfWidth], sdfWidth);
+        MemoryFree(sdf);
+
+        glyphs[i].codepoint = firstCodepoint + i;
+        glyphs[i].rect = CLITERAL(Rectangle){ .x=atlasX, .y=atlasY, .width=sdfWidth, .height=sdfHeight };
+    }
+
+    // Distance fields are magnified far more than minified, mipmaps would only blur the edge
+    bool result = LoadTextureEx(&font->texture, atlas, atlasWidth, atlasHeight, CLITERAL(TextureDesc){
+        .format = PIXEL_FORMAT_R8,
+        .mipmaps = TEXTURE_MIPMAPS_NONE,
+        .filter = TEXTURE_FILTER_BILINEAR,
+        .wrap = TEXTURE_WRAP_CLAMP,
+        .immutable = true,
+    });
+    MemoryFree(cell);
+    MemoryFree(atlas);
+    if(!result) {
+        MemoryFree(glyphs);
+        return false;
+    }
+
+    font->baseSize = glyphHeight / downscale;
+    font->glyphWidth = glyphWidth / downscale;
+    font->glyphPadding = padding;
+    font->firstCodepoint = firstCodepoint;
+    font->glyphCount = glyphCount;
+    font->glyphs = glyphs;
+    TRACELOG(LOG_INFO, "Loaded SDF font with %d glyphs (%ux%u atlas)", glyphCount, atlasWidth, atlasHeight);
+    return true;
+}
+
+void UnloadFont(Font font)
+{
+    UnloadTexture(font.texture);
+    MemoryFree(font.glyphs);
+}
@@ -0,0 +1,128 @@
+#include "noe.h"
+#include "noe_internal.h"
+#include "nomath.h"
+
+#include <stdatomic.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TRANSFORM_SPIN_PAUSE() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+    #define TRANSFORM_SPIN_PAUSE() __asm__ __volatile__("yield")
+#else
+    #define TRANSFORM_SPIN_PAUSE() ((void)0)
+#endif
+
+#ifndef PARALLEL_TRANSFORM_MIN_POINTS
+    #define PARALLEL_TRANSFORM_MIN_POINTS 16384 // Points of a chunk, fewer take longer to hand to a worker than to transform
+#endif
+#define TRANSFORM_CHUNKS (MAXIMUM_WORKER_THREADS + 1) // The calling thread transforms a chunk too
+#define TRANSFORM_GENERATION_MASK 0x0fffffffu // Leaves room for the chunk index in a job ticket
+#define TRANSFORM_SPINS_BEFORE_YIELD 64 // A chunk still running after that many pauses may be on a descheduled worker
+
+typedef enum _TransformChunkState {
+    TRANSFORM_CHUNK_PENDING = 0,
+    TRANSFORM_CHUNK_CLAIMED,
+    TRANSFORM_CHUNK_DONE,
+} _TransformChunkState;
+
+/**
+ * Range of points one thread transforms. Jobs still queued from an earlier call carry that call's
+ * generation in their ticket and find the chunk taken, so only one thread ever claims it.
+ */
+typedef struct _TransformChunk {
+    atomic_uint state; // Generation << 2 | `_TransformChunkState`
+    size_t first, count;
+} _TransformChunk;
+
+static struct {
+    _TransformChunk chunks[TRANSFORM_CHUNKS];
+    uint32_t generation;
+    int dimensions;
+    Matrix matrix;
+    const void *in;
+    void *out;
+} TRANSFORMS = {0};
+
+static void transformRange(size_t first, size_t count)
+{
+    const Matrix *m = &TRANSFORMS.matrix;
+    switch(TRANSFORMS.dimensions) {
+        case 2: TransformPoints2D(m, (const Vector2 *)TRANSFORMS.in + first, (Vector2 *)TRANSFORMS.out + first, count); break;
+        case 3: TransformPoints3D(m, (const Vector3 *)TRANSFORMS.in + first, (Vector3 *)TRANSFORMS.out + first, count); break;
+        case 4: TransformPoints4D(m, (const Vector4 *)TRANSFORMS.in + first, (Vector4 *)TRANSFORMS.out + first, count); break;
+    }
+}
+
+static void runTransformChunk(uint32_t index, uint32_t generation)
+{
+    _TransformChunk *chunk = &TRANSFORMS.chunks[index];
+    unsigned int expected = (generation << 2) | TRANSFORM_CHUNK_PENDING;
+    if(!atomic_compare_exchange_strong_explicit(&chunk->state, &expected, (generation << 2) | TRANSFORM_CHUNK_CLAIMED,
+            memory_order_acquire, memory_order_relaxed)) return;
+    transformRange(chunk->first, chunk->count);
+    atomic_store_explicit(&chunk->state, (generation << 2) | TRANSFORM_CHUNK_DONE, memory_order_release);
+}
+
+static void transformChunkJob(void *userData)
+{
+    uintptr_t ticket = (uintptr_t)userData;
+    runTransformChunk((uint32_t)(ticket % TRANSFORM_CHUNKS), (uint32_t)(ticket / TRANSFORM_CHUNKS));
+}
+
+static void transformPointsParallel(int dimensions, const Matrix *matrix, const void *in, void *out, size_t count)
+{
+    TRANSFORMS.dimensions = dimensions;
+    TRANSFORMS.matrix = *matrix;
+    TRANSFORMS.in = in;
+    TRANSFORMS.out = out;
+
+    size_t chunkCount = count / PARALLEL_TRANSFORM_MIN_POINTS;
+    if(chunkCount > TRANSFORM_CHUNKS) chunkCount = TRANSFORM_CHUNKS;
+    if(chunkCount < 2) {
+        transformRange(0, count);
+        return;
+    }
+
+    uint32_t generation = TRANSFORMS.generation = (TRANSFORMS.generation + 1) & TRANSFORM_GENERATION_MASK;
+    size_t first = 0;
+    for(uint32_t i = 0; i < chunkCount; ++i) {
+        _TransformChunk *chunk = &TRANSFORMS.chunks[i];
+        chunk->first = first;
+        chunk->count = count*(i + 1)/chunkCount - first;
+        first += chunk->count;
+        atomic_store_explicit(&chunk->state, (generation << 2) | TRANSFORM_CHUNK_PENDING, memory_order_release);
+    }
+
+    // A chunk no worker picked up, with the queue full or before workers started, is done below
+    for(uint32_t i = 1; i < chunkCount; ++i) {
+        platformSubmitJob(transformChunkJob, (void *)((uintptr_t)generation*TRANSFORM_CHUNKS + i));
+    }
+    for(uint32_t i = 0; i < chunkCount; ++i) runTransformChunk(i, generation);
+    for(uint32_t i = 0; i < chunkCount; ++i) {
+        uint32_t spins = 0;
+        while((atomic_load_explicit(&TRANSFORMS.chunks[i].state, memory_order_acquire) & 3) != TRANSFORM_CHUNK_DONE) {
+            if(++spins < TRANSFORM_SPINS_BEFORE_YIELD) TRANSFORM_SPIN_PAUSE();
+            else platformYieldThread();
+        }
+    }
+}
+
+/**
+ * `TransformPoints*()` split over the worker threads once there are enough points to pay for it,
+ * the calling thread transforms a share too and returns when every point is done.
+ * Call from one thread at a time, never from a worker job.
+ */
+void TransformPoints2DParallel(const Matrix *matrix, const Vector2 *in, Vector2 *out, size_t count)
+{
+    transformPointsParallel(2, matrix, in, out, count);
+}
+
+void TransformPoints3DParallel(const Matrix *matrix, const Vector3 *in, Vector3 *out, size_t count)
+{
+    transformPointsParallel(3, matrix, in, out, count);
+}
+
+void TransformPoints4DParallel(const Matrix *matrix, const Vector4 *in, Vector4 *out, size_t count)
+{
+    transformPointsParallel(4, matrix, in, out, count);
+}
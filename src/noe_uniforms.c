@@ -0,0 +1,582 @@
+#include "noe.h"
+#include "noe_internal.h"
+
+#include <glad/glad.h>
+
+// Set on the locations of the fragment stage of a pipeline, GL locations are non-negative ints that never reach it
+#define PIPELINE_FRAGMENT_LOCATION BIT(30)
+
+// FNV-1a, never 0 since that marks an empty slot
+uint32_t hashShaderVariableName(const char *name, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < length; ++i) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+static int getUniformType(uint32_t glType)
+{
+    switch(glType) {
+        case GL_FLOAT: return SHADER_UNIFORM_FLOAT;
+        case GL_FLOAT_VEC2: return SHADER_UNIFORM_VEC2;
+        case GL_FLOAT_VEC3: return SHADER_UNIFORM_VEC3;
+        case GL_FLOAT_VEC4: return SHADER_UNIFORM_VEC4;
+        case GL_UNSIGNED_INT: return SHADER_UNIFORM_UINT;
+        case GL_UNSIGNED_INT_VEC2: return SHADER_UNIFORM_UVEC2;
+        case GL_UNSIGNED_INT_VEC3: return SHADER_UNIFORM_UVEC3;
+        case GL_UNSIGNED_INT_VEC4: return SHADER_UNIFORM_UVEC4;
+        case GL_INT: case GL_BOOL: return SHADER_UNIFORM_INT;
+        case GL_INT_VEC2: case GL_BOOL_VEC2: return SHADER_UNIFORM_IVEC2;
+        case GL_INT_VEC3: case GL_BOOL_VEC3: return SHADER_UNIFORM_IVEC3;
+        case GL_INT_VEC4: case GL_BOOL_VEC4: return SHADER_UNIFORM_IVEC4;
+        case GL_FLOAT_MAT3: return SHADER_UNIFORM_MAT3;
+        case GL_FLOAT_MAT4: return SHADER_UNIFORM_MAT4;
+        case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_ARRAY: case GL_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_2D:
+            return SHADER_UNIFORM_SAMPLER;
+        default: return INVALID_SHADER_UNIFORM;
+    }
+}
+
+// 32 bit components of one element of a uniform type
+static uint32_t getUniformComponents(int type)
+{
+    switch(type) {
+        case SHADER_UNIFORM_VEC2: case SHADER_UNIFORM_UVEC2: case SHADER_UNIFORM_IVEC2: return 2;
+        case SHADER_UNIFORM_VEC3: case SHADER_UNIFORM_UVEC3: case SHADER_UNIFORM_IVEC3: return 3;
+        case SHADER_UNIFORM_VEC4: case SHADER_UNIFORM_UVEC4: case SHADER_UNIFORM_IVEC4: return 4;
+        case SHADER_UNIFORM_MAT3: return 9;
+        case SHADER_UNIFORM_MAT4: return 16;
+        case INVALID_SHADER_UNIFORM: return 0;
+        default: return 1;
+    }
+}
+
+static void uploadUniform(int location, int uniformType, const void *data, int count, bool transposeIfMatrix)
+{
+    switch(uniformType) {
+        case SHADER_UNIFORM_FLOAT:
+            glUniform1fv(location, count, (const float *)data);
+            break;
+        case SHADER_UNIFORM_VEC2:
+            glUniform2fv(location, count, (const float *)data);
+            break;
+        case SHADER_UNIFORM_VEC3:
+            glUniform3fv(location, count, (const float *)data);
+            break;
+        case SHADER_UNIFORM_VEC4:
+            glUniform4fv(location, count, (const float *)data);
+            break;
+        case SHADER_UNIFORM_UINT:
+            glUniform1uiv(location, count, (const uint32_t *)data);
+            break;
+        case SHADER_UNIFORM_UVEC2:
+            glUniform2uiv(location, count, (const uint32_t *)data);
+            break;
+        case SHADER_UNIFORM_UVEC3:
+            glUniform3uiv(location, count, (const uint32_t *)data);
+            break;
+        case SHADER_UNIFORM_UVEC4:
+            glUniform4uiv(location, count, (const uint32_t *)data);
+            break;
+        case SHADER_UNIFORM_INT:
+            glUniform1iv(location, count, (const int *)data);
+            break;
+        case SHADER_UNIFORM_IVEC2:
+            glUniform2iv(location, count, (const int *)data);
+            break;
+        case SHADER_UNIFORM_IVEC3:
+            glUniform3iv(location, count, (const int *)data);
+            break;
+        case SHADER_UNIFORM_IVEC4:
+            glUniform4iv(location, count, (const int *)data);
+            break;
+        case SHADER_UNIFORM_MAT3:
+            glUniformMatrix3fv(location, count, transposeIfMatrix ? GL_TRUE : GL_FALSE, (const float *)data);
+            break;
+        case SHADER_UNIFORM_MAT4:
+            glUniformMatrix4fv(location, count, transposeIfMatrix ? GL_TRUE : GL_FALSE, (const float *)data);
+            break;
+        case SHADER_UNIFORM_SAMPLER:
+            glUniform1iv(location, count, data);
+            break;
+        default:
+            break;
+    }
+}
+
+static _ShaderVariable *findSlot(_ShaderVariableMap *map, uint32_t hash)
+{
+    uint32_t mask = map->capacity - 1;
+    for(uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        if(map->slots[i].hash == 0 || map->slots[i].hash == hash) return &map->slots[i];
+    }
+}
+
+static bool isPipeline(const _ShaderVariables *variables)
+{
+    return variables && variables->vertProgram != 0;
+}
+
+/**
+ * Program a location of `shader` belongs to, `location` becomes the one inside it.
+ * Pipelines mark the uniforms of their fragment stage with PIPELINE_FRAGMENT_LOCATION.
+ */
+static uint32_t getLocationProgram(Shader shader, int *location)
+{
+    if(!isPipeline(shader.variables)) return shader.ID;
+    if(*location < 0 || !(*location & PIPELINE_FRAGMENT_LOCATION)) return shader.variables->vertProgram;
+    *location &= ~PIPELINE_FRAGMENT_LOCATION;
+    return shader.variables->fragProgram;
+}
+
+// Pipelines bind no program, `glUniform*()` goes to the active program of the bound pipeline
+static void selectLocationProgram(Shader shader, int *location)
+{
+    uint32_t program = getLocationProgram(shader, location);
+    if(isPipeline(shader.variables)) glActiveShaderProgram(shader.ID, program);
+}
+
+static int countVariables(uint32_t program, bool uniforms)
+{
+    int count = 0;
+    glGetProgramiv(program, uniforms ? GL_ACTIVE_UNIFORMS : GL_ACTIVE_ATTRIBUTES, &count);
+    return count;
+}
+
+static bool allocateVariableMap(_ShaderVariableMap *map, int count)
+{
+    uint32_t capacity = 8;
+    while(capacity < (uint32_t)count*2) capacity *= 2;
+    map->slots = MemoryAlloc(sizeof(_ShaderVariable)*capacity);
+    if(!map->slots) return false;
+    MemorySet(map->slots, 0, sizeof(_ShaderVariable)*capacity);
+    map->capacity = capacity;
+    map->count = 0;
+    return true;
+}
+
+/**
+ * Query every active uniform or attribute of `program` into `map`, their locations get `locationFlags`.
+ * A uniform already in `map` from the other stage of a pipeline keeps this location as its fragment stage one.
+ */
+static void reflectVariables(_ShaderVariableMap *map, uint32_t program, bool uniforms, int locationFlags)
+{
+    int count = countVariables(program, uniforms);
+    for(int i = 0; i < count; ++i) {
+        char name[MAXIMUM_SHADER_VARIABLE_NAME];
+        int length = 0, size = 0;
+        uint32_t glType = 0;
+        if(uniforms) glGetActiveUniform(program, (uint32_t)i, sizeof(name), &length, &size, &glType, name);
+        else glGetActiveAttrib(program, (uint32_t)i, sizeof(name), &length, &size, &glType, name);
+        if(length <= 0 || length >= (int)sizeof(name) - 1) continue; // Possibly cut off, the driver answers those
+        // Built-in inputs and uniform block members have no location
+        int location = uniforms ? glGetUniformLocation(program, name) : glGetAttribLocation(program, name);
+        if(location < 0) continue;
+        if(length > 3 && MemoryCompare(&name[length - 3], "[0]", 3) == 0) {
+            length -= 3;
+            name[length] = '\0';
+        }
+
+        uint32_t hash = hashShaderVariableName(name, (size_t)length);
+        _ShaderVariable *variable = findSlot(map, hash);
+        if(variable->hash == hash) {
+            if(MemoryCompare(variable->name, name, (size_t)length + 1) == 0) {
+                if(variable->type == getUniformType(glType) && variable->size == size) {
+                    variable->fragLocation = location | locationFlags;
+                } else {
+                    TRACELOG(LOG_WARNING, "Uniform \"%s\" has another type in each stage of a pipeline, only the vertex stage one is set", name);
+                }
+            } else {
+                TRACELOG(LOG_WARNING, "Shader variables \"%s\" and \"%s\" have the same hash, only the first is reflected", variable->name, name);
+            }
+            continue;
+        }
+        variable->hash = hash;
+        variable->location = location | locationFlags;
+        variable->fragLocation = -1;
+        variable->type = uniforms ? getUniformType(glType) : INVALID_SHADER_UNIFORM;
+        variable->size = size;
+        MemoryCopy(variable->name, name, (size_t)length + 1);
+        map->count += 1;
+    }
+}
+
+static void freeVariableTables(_ShaderVariables *variables)
+{
+    MemoryFree(variables->uniforms.slots);
+    MemoryFree(variables->attributes.slots);
+    MemoryFree(variables->values);
+    MemoryFree(variables->elementLocations);
+    MemoryFree(variables->slotByLocation);
+    MemoryFree(variables->elementByLocation);
+    MemoryFree(variables->dirtySlots);
+}
+
+/**
+ * Location of element `element` of an array uniform starting at `firstLocation`, asked for by name
+ * since drivers are free to number the elements in any order
+ */
+static int queryElementLocation(Shader shader, const char *uniformName, int firstLocation, int element)
+{
+    if(element == 0) return firstLocation;
+    char name[MAXIMUM_SHADER_VARIABLE_NAME + 16];
+    size_t length = StringLength(uniformName) - 1;
+    MemoryCopy(name, uniformName, length);
+    name[length++] = '[';
+    char digits[12];
+    int digitCount = 0;
+    for(int value = element; value > 0; value /= 10) digits[digitCount++] = (char)('0' + value % 10);
+    while(digitCount > 0) name[length++] = digits[--digitCount];
+    name[length++] = ']';
+    name[length] = '\0';
+
+    int location = firstLocation;
+    uint32_t program = getLocationProgram(shader, &location);
+    int elementLocation = glGetUniformLocation(program, name);
+    if(elementLocation < 0) return -1;
+    return elementLocation | (firstLocation - location); // Keeps the stage flag
+}
+
+// Lay out the shadow copy of the uniforms and fill it with the values the program has now
+static bool setupUniformStaging(Shader shader)
+{
+    _ShaderVariables *variables = shader.variables;
+    _ShaderVariableMap *map = &variables->uniforms;
+    size_t valuesSize = 0;
+    uint32_t elementCount = 0;
+    for(uint32_t i = 0; i < map->capacity; ++i) {
+        _ShaderVariable *uniform = &map->slots[i];
+        if(uniform->hash == 0) continue;
+        uint32_t components = getUniformComponents(uniform->type);
+        uniform->offset = (uint32_t)valuesSize;
+        uniform->firstElement = elementCount;
+        uniform->synced = components > 0;
+        valuesSize += (size_t)components*4*uniform->size;
+        // The fragment stage locations of a uniform both stages of a pipeline declare follow the vertex stage ones
+        elementCount += (uint32_t)uniform->size*(uniform->fragLocation >= 0 ? 2 : 1);
+    }
+
+    variables->values = MemoryAlloc(valuesSize > 0 ? valuesSize : 1);
+    variables->elementLocations = MemoryAlloc(sizeof(int)*(elementCount > 0 ? elementCount : 1));
+    variables->dirtySlots = MemoryAlloc(sizeof(uint32_t)*map->capacity);
+    if(!variables->values || !variables->elementLocations || !variables->dirtySlots) return false;
+    MemorySet(variables->values, 0, valuesSize);
+    int locationCount = 0;
+    for(uint32_t i = 0; i < map->capacity; ++i) {
+        const _ShaderVariable *uniform = &map->slots[i];
+        if(uniform->hash == 0) continue;
+        bool supported = getUniformComponents(uniform->type) > 0;
+        for(int element = 0; element < uniform->size; ++element) {
+            int location = supported ? queryElementLocation(shader, uniform->name, uniform->location, element) : -1;
+            variables->elementLocations[uniform->firstElement + (uint32_t)element] = location;
+            if(location >= locationCount && !(location & PIPELINE_FRAGMENT_LOCATION)) locationCount = location + 1;
+            if(uniform->fragLocation < 0) continue;
+            variables->elementLocations[uniform->firstElement + (uint32_t)(uniform->size + element)] =
+                supported ? queryElementLocation(shader, uniform->name, uniform->fragLocation, element) : -1;
+        }
+    }
+
+    variables->slotByLocation = MemoryAlloc(sizeof(int)*(locationCount > 0 ? locationCount : 1));
+    variables->elementByLocation = MemoryAlloc(sizeof(int)*(locationCount > 0 ? locationCount : 1));
+    if(!variables->slotByLocation || !variables->elementByLocation) return false;
+    variables->locationCount = locationCount;
+    for(int i = 0; i < locationCount; ++i) variables->slotByLocation[i] = -1;
+    for(uint32_t i = 0; i < map->capacity; ++i) {
+        _ShaderVariable *uniform = &map->slots[i];
+        if(uniform->hash == 0 || getUniformComponents(uniform->type) == 0) continue;
+        size_t stride = (size_t)getUniformComponents(uniform->type)*4;
+        for(int element = 0; element < uniform->size; ++element) {
+            int location = variables->elementLocations[uniform->firstElement + (uint32_t)element];
+            if(location < 0) {
+                // Never uploaded through the shadow copy, so it can not be trusted to match the program
+                uniform->synced = false;
+                continue;
+            }
+            void *value = variables->values + uniform->offset + (size_t)element*stride;
+            // Pipelines never stage, only their vertex stage locations are mapped to find the fragment stage ones
+            if(!(location & PIPELINE_FRAGMENT_LOCATION)) {
+                variables->slotByLocation[location] = (int)i;
+                variables->elementByLocation[location] = element;
+            }
+            uint32_t program = getLocationProgram(shader, &location);
+            switch(uniform->type) {
+                case SHADER_UNIFORM_FLOAT: case SHADER_UNIFORM_VEC2: case SHADER_UNIFORM_VEC3: case SHADER_UNIFORM_VEC4:
+                case SHADER_UNIFORM_MAT3: case SHADER_UNIFORM_MAT4:
+                    glGetUniformfv(program, location, value);
+                    break;
+                case SHADER_UNIFORM_UINT: case SHADER_UNIFORM_UVEC2: case SHADER_UNIFORM_UVEC3: case SHADER_UNIFORM_UVEC4:
+                    glGetUniformuiv(program, location, value);
+                    break;
+                default:
+                    glGetUniformiv(program, location, value);
+                    break;
+            }
+        }
+    }
+    return true;
+}
+
+static bool reflectVariableTables(Shader *shader, uint32_t vertProgram, uint32_t fragProgram)
+{
+    _ShaderVariables *variables = shader->variables;
+    if(!variables) {
+        variables = MemoryAlloc(sizeof(_ShaderVariables));
+        if(!variables) return false;
+    } else {
+        freeVariableTables(variables);
+    }
+    MemorySet(variables, 0, sizeof(*variables));
+    variables->vertProgram = vertProgram;
+    variables->fragProgram = fragProgram;
+    shader->variables = variables;
+
+    // Attributes and the uniforms of the vertex stage come from the same program
+    uint32_t program = vertProgram != 0 ? vertProgram : shader->ID;
+    int uniformCount = countVariables(program, true) + (fragProgram != 0 ? countVariables(fragProgram, true) : 0);
+    if(!allocateVariableMap(&variables->uniforms, uniformCount) ||
+            !allocateVariableMap(&variables->attributes, countVariables(program, false))) {
+        TRACELOG(LOG_ERROR, "Failed to reflect the variables of shader with id %u", shader->ID);
+        return false;
+    }
+    reflectVariables(&variables->uniforms, program, true, 0);
+    if(fragProgram != 0) reflectVariables(&variables->uniforms, fragProgram, true, PIPELINE_FRAGMENT_LOCATION);
+    reflectVariables(&variables->attributes, program, false, 0);
+    if(!setupUniformStaging(*shader)) {
+        TRACELOG(LOG_ERROR, "Failed to reflect the variables of shader with id %u", shader->ID);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Copies of a shader share its table like they share `locs`,
+ * so a program replaced in place gets its new table through every copy.
+ */
+bool reflectShaderVariables(Shader *shader)
+{
+    return reflectVariableTables(shader, 0, 0);
+}
+
+// The table of a program pipeline holds the uniforms of both stage programs
+bool reflectPipelineVariables(Shader *shader, uint32_t vertProgram, uint32_t fragProgram)
+{
+    return reflectVariableTables(shader, vertProgram, fragProgram);
+}
+
+void freeShaderVariables(Shader shader)
+{
+    if(!shader.variables) return;
+    freeVariableTables(shader.variables);
+    MemoryFree(shader.variables);
+}
+
+const _ShaderVariable *findShaderVariable(const _ShaderVariableMap *map, uint32_t hash, const char *name)
+{
+    if(!map->slots) return NULL;
+    const _ShaderVariable *variable = findSlot((_ShaderVariableMap *)map, hash);
+    if(variable->hash != hash) return NULL;
+    if(name) {
+        size_t size = StringLength(name);
+        if(size > MAXIMUM_SHADER_VARIABLE_NAME || MemoryCompare(variable->name, name, size) != 0) return NULL;
+    }
+    return variable;
+}
+
+// Reflected names carry no array index, names with one are left to the driver
+static bool hasArrayIndex(const char *name, size_t *length)
+{
+    bool result = false;
+    size_t i = 0;
+    for(; name[i]; ++i) {
+        if(name[i] == '[') result = true;
+    }
+    *length = i;
+    return result;
+}
+
+static int queryUniformLocation(Shader shader, const char *uniformName)
+{
+    if(!isPipeline(shader.variables)) return glGetUniformLocation(shader.ID, uniformName);
+    int location = glGetUniformLocation(shader.variables->vertProgram, uniformName);
+    if(location >= 0) return location;
+    location = glGetUniformLocation(shader.variables->fragProgram, uniformName);
+    return location >= 0 ? location | PIPELINE_FRAGMENT_LOCATION : -1;
+}
+
+int GetShaderUniformLocation(Shader shader, const char *uniformName)
+{
+    size_t length;
+    if(!shader.variables || hasArrayIndex(uniformName, &length)) return queryUniformLocation(shader, uniformName);
+    const _ShaderVariable *uniform = findShaderVariable(&shader.variables->uniforms,
+            hashShaderVariableName(uniformName, length), uniformName);
+    return uniform ? uniform->location : -1;
+}
+
+int GetShaderAttributeLocation(Shader shader, const char *attributeName)
+{
+    size_t length;
+    if(!shader.variables || hasArrayIndex(attributeName, &length)) {
+        return glGetAttribLocation(isPipeline(shader.variables) ? shader.variables->vertProgram : shader.ID, attributeName);
+    }
+    const _ShaderVariable *attribute = findShaderVariable(&shader.variables->attributes,
+            hashShaderVariableName(attributeName, length), attributeName);
+    return attribute ? attribute->location : -1;
+}
+
+uint32_t GetShaderUniformID(const char *uniformName)
+{
+    size_t length;
+    hasArrayIndex(uniformName, &length);
+    return hashShaderVariableName(uniformName, length);
+}
+
+// Location of a uniform by `GetShaderUniformID()`, without comparing names or asking the driver
+int GetShaderUniformLocationByID(Shader shader, uint32_t uniformID)
+{
+    if(!shader.variables) return -1;
+    const _ShaderVariable *uniform = findShaderVariable(&shader.variables->uniforms, uniformID, NULL);
+    return uniform ? uniform->location : -1;
+}
+
+/**
+ * Shadow copy of the uniforms so setting a value the program already has costs a compare,
+ * changed ones are uploaded by `uploadShaderUniforms()` right before the next draw with the shader.
+ */
+bool stageShaderUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix)
+{
+    _ShaderVariables *variables = shader.variables;
+    // Uniforms of a stage program are shared by every pipeline using it, a shadow copy per pipeline would go stale
+    if(isPipeline(variables)) return false;
+    if(!variables || location < 0 || location >= variables->locationCount) return false;
+    int slot = variables->slotByLocation[location];
+    if(slot < 0) return false;
+    _ShaderVariable *uniform = &variables->uniforms.slots[slot];
+    if(uniform->type != uniformType) {
+        // Uploaded as asked, the driver reports the mismatch
+        uniform->synced = false;
+        return false;
+    }
+
+    int first = variables->elementByLocation[location];
+    if(count > uniform->size - first) count = uniform->size - first;
+    if(count <= 0) return true;
+
+    uint32_t components = getUniformComponents(uniformType);
+    size_t stride = (size_t)components*4;
+    uint8_t *shadow = variables->values + uniform->offset + (size_t)first*stride;
+    bool transpose = transposeIfMatrix && (uniformType == SHADER_UNIFORM_MAT3 || uniformType == SHADER_UNIFORM_MAT4);
+    bool changed = !uniform->synced;
+    for(int i = 0; i < count; ++i) {
+        const uint8_t *element = (const uint8_t *)data + (size_t)i*stride;
+        float transposed[16];
+        if(transpose) {
+            uint32_t n = uniformType == SHADER_UNIFORM_MAT3 ? 3 : 4;
+            const float *matrix = (const float *)element;
+            for(uint32_t row = 0; row < n; ++row) {
+                for(uint32_t column = 0; column < n; ++column) transposed[column*n + row] = matrix[row*n + column];
+            }
+            element = (const uint8_t *)transposed;
+        }
+        if(MemoryCompare(shadow + (size_t)i*stride, element, stride) != 0) {
+            MemoryCopy(shadow + (size_t)i*stride, element, stride);
+            changed = true;
+        }
+    }
+    if(!changed) return true;
+
+    if(uniform->dirtyEnd == 0) {
+        variables->dirtySlots[variables->dirtyCount++] = (uint32_t)slot;
+        uniform->dirtyFirst = first;
+        uniform->dirtyEnd = first + count;
+    } else {
+        if(first < uniform->dirtyFirst) uniform->dirtyFirst = first;
+        if(first + count > uniform->dirtyEnd) uniform->dirtyEnd = first + count;
+    }
+    return true;
+}
+
+void uploadShaderUniforms(Shader shader)
+{
+    _ShaderVariables *variables = shader.variables;
+    if(!variables) return;
+    for(uint32_t i = 0; i < variables->dirtyCount; ++i) {
+        _ShaderVariable *uniform = &variables->uniforms.slots[variables->dirtySlots[i]];
+        size_t stride = (size_t)getUniformComponents(uniform->type)*4;
+        // Elements after the first one of an upload are set in array order, whatever their locations
+        int location = variables->elementLocations[uniform->firstElement + (uint32_t)uniform->dirtyFirst];
+        selectLocationProgram(shader, &location);
+        uploadUniform(location, uniform->type,
+                variables->values + uniform->offset + (size_t)uniform->dirtyFirst*stride,
+                uniform->dirtyEnd - uniform->dirtyFirst, false);
+        if(uniform->dirtyFirst == 0 && uniform->dirtyEnd == uniform->size) uniform->synced = true;
+        uniform->dirtyFirst = uniform->dirtyEnd = 0;
+    }
+    variables->dirtyCount = 0;
+}
+
+// Upload to the program `location` belongs to, a uniform both stages of a pipeline declare is set in both
+static void uploadLocationUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix)
+{
+    _ShaderVariables *variables = shader.variables;
+    int fragLocation = -1;
+    if(isPipeline(variables) && location >= 0 && location < variables->locationCount && variables->slotByLocation[location] >= 0) {
+        const _ShaderVariable *uniform = &variables->uniforms.slots[variables->slotByLocation[location]];
+        if(uniform->fragLocation >= 0) {
+            int element = variables->elementByLocation[location];
+            fragLocation = variables->elementLocations[uniform->firstElement + (uint32_t)(uniform->size + element)];
+        }
+    }
+    selectLocationProgram(shader, &location);
+    uploadUniform(location, uniformType, data, count, transposeIfMatrix);
+    if(fragLocation < 0) return;
+    selectLocationProgram(shader, &fragLocation);
+    uploadUniform(fragLocation, uniformType, data, count, transposeIfMatrix);
+}
+
+void uploadShaderUniform(Shader shader, int location, int uniformType, const void *data, int count)
+{
+    uploadLocationUniform(shader, location, uniformType, data, count, false);
+}
+
+/**
+ * Values of uniforms the shader reflected are staged and reach the program with the next `RenderFlush()`
+ * that uses it, setting the value it already has does nothing. Others are uploaded right away.
+ */
+void SetShaderUniform(Shader shader, int location, int uniformType, const void *data, int count, bool transposeIfMatrix)
+{
+    if(stageShaderUniform(shader, location, uniformType, data, count, transposeIfMatrix)) return;
+    pipelineBindShader(shader);
+    uploadLocationUniform(shader, location, uniformType, data, count, transposeIfMatrix);
+    pipelineUnbindShader(shader);
+}
+
+static bool setReflectedUniform(Shader shader, const _ShaderVariable *uniform, const void *data, int count)
+{
+    if(!uniform || uniform->type == INVALID_SHADER_UNIFORM) return false;
+    if(count > uniform->size) count = uniform->size;
+    SetShaderUniform(shader, uniform->location, uniform->type, data, count, false);
+    return true;
+}
+
+/**
+ * Set `count` elements of a uniform with the type the shader declares it with,
+ * false when the shader has no such uniform or its type has no `NoeShaderUniformType`
+ */
+bool SetShaderUniformByName(Shader shader, const char *uniformName, const void *data, int count)
+{
+    if(!shader.variables) return false;
+    size_t length;
+    if(hasArrayIndex(uniformName, &length)) return false;
+    return setReflectedUniform(shader, findShaderVariable(&shader.variables->uniforms,
+                hashShaderVariableName(uniformName, length), uniformName), data, count);
+}
+
+bool SetShaderUniformByID(Shader shader, uint32_t uniformID, const void *data, int count)
+{
+    if(!shader.variables) return false;
+    return setReflectedUniform(shader, findShaderVariable(&shader.variables->uniforms, uniformID, NULL), data, count);
+}
@@ -35,6 +35,8 @@
 #define RAD2DEG(rad) (((180.0f/(PI))*(deg))
 #endif
 
+#include <stddef.h> // size_t
+
 #ifndef NOMATH_TYPES
 #define NOMATH_TYPES
 typedef union Vector2 {
@@ -103,6 +105,28 @@ float Vector3Length(Vector3 a);
 Vector3 Vector3Normalize(Vector3 a);
 Vector3 Vector3Cross(Vector3 a, Vector3 b);
 
+Vector4 Vector4Add(Vector4 a, Vector4 b);
+Vector4 Vector4Sub(Vector4 a, Vector4 b);
+float Vector4Dot(Vector4 a, Vector4 b);
+float Vector4LengthSqr(Vector4 a);
+float Vector4Length(Vector4 a);
+Vector4 Vector4Normalize(Vector4 a);
+
+// Vectors are rows multiplied on the left of the matrix, the way `MatrixDot()` composes transformations
+Vector2 Vector2Transform(Vector2 v, Matrix m); // z = 0, w = 1
+Vector3 Vector3Transform(Vector3 v, Matrix m); // w = 1, without the perspective divide
+Vector4 Vector4Transform(Vector4 v, Matrix m);
+
+// `Vector*Transform()` over `count` points at once, `out` may be `in` but no other overlap is allowed.
+// Results match up to float rounding, the compiler may fuse the scalar math into FMA and NEON sums in another order
+void TransformPoints2D(const Matrix *m, const Vector2 *in, Vector2 *out, size_t count);
+void TransformPoints3D(const Matrix *m, const Vector3 *in, Vector3 *out, size_t count);
+void TransformPoints4D(const Matrix *m, const Vector4 *in, Vector4 *out, size_t count);
+// Points stored as one array per coordinate, the layout the vector units load without shuffling
+void TransformPoints2DSoA(const Matrix *m, const float *inX, const float *inY, float *outX, float *outY, size_t count);
+void TransformPoints3DSoA(const Matrix *m, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t count);
+
 Matrix MatrixCreate(float eye);
 Matrix MatrixAdd(Matrix a, Matrix b);
 Matrix MatrixSub(Matrix a, Matrix b);
@@ -123,6 +147,175 @@ Matrix MatrixLookAt(Vector3 pos, Vector3 target, Vector3 up);
 
 #include <math.h> // 
 
+// Picked at compile time, define NOMATH_NO_SIMD for the scalar code everywhere
+#ifndef NOMATH_NO_SIMD
+    #if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #define NOMATH_SSE
+        #include <xmmintrin.h>
+        #if defined(__AVX__)
+            #define NOMATH_AVX
+            #include <immintrin.h>
+        #endif
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define NOMATH_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(NOMATH_SSE)
+// row * m, with the rows of `m` already loaded
+static inline __m128 nomathRowTimesRows(__m128 row, __m128 rows0, __m128 rows1, __m128 rows2, __m128 rows3)
+{
+    __m128 result = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), rows0);
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), rows1));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xaa), rows2));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xff), rows3));
+    return result;
+}
+
+// row * m, the rows of `m` weighted by the lanes of `row`
+static inline __m128 nomathRowTimesMatrix(__m128 row, const Matrix *m)
+{
+    return nomathRowTimesRows(row, _mm_loadu_ps(m->rows[0].elements), _mm_loadu_ps(m->rows[1].elements),
+            _mm_loadu_ps(m->rows[2].elements), _mm_loadu_ps(m->rows[3].elements));
+}
+
+// Column `j` of four points transformed at once, one register per coordinate, z = 0 for `nomathTransform4x2()`
+static inline __m128 nomathTransform4x3(const Matrix *m, int j, __m128 x, __m128 y, __m128 z)
+{
+    __m128 result = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m->elements[j])), _mm_mul_ps(y, _mm_set1_ps(m->elements[4 + j])));
+    result = _mm_add_ps(result, _mm_mul_ps(z, _mm_set1_ps(m->elements[8 + j])));
+    return _mm_add_ps(result, _mm_set1_ps(m->elements[12 + j]));
+}
+
+static inline __m128 nomathTransform4x2(const Matrix *m, int j, __m128 x, __m128 y)
+{
+    __m128 result = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m->elements[j])), _mm_mul_ps(y, _mm_set1_ps(m->elements[4 + j])));
+    return _mm_add_ps(result, _mm_set1_ps(m->elements[12 + j]));
+}
+
+// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to one register per coordinate
+static inline void nomathSplitPoints(__m128 a, __m128 b, __m128 c, __m128 *x, __m128 *y, __m128 *z)
+{
+    *x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    *y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// Inverse of `nomathSplitPoints()`
+static inline void nomathMergePoints(__m128 x, __m128 y, __m128 z, __m128 *a, __m128 *b, __m128 *c)
+{
+    *a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline float nomathSum(__m128 v)
+{
+    __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 0x55)));
+}
+
+#if defined(NOMATH_AVX)
+// `nomathRowTimesMatrix()` for two rows, `rows0` to `rows3` hold each row of the matrix in both halves
+static inline __m256 nomathRowPairTimesMatrix(__m256 pair, __m256 rows0, __m256 rows1, __m256 rows2, __m256 rows3)
+{
+    __m256 result = _mm256_mul_ps(_mm256_shuffle_ps(pair, pair, 0x00), rows0);
+    result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(pair, pair, 0x55), rows1));
+    result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(pair, pair, 0xaa), rows2));
+    result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(pair, pair, 0xff), rows3));
+    return result;
+}
+
+// `nomathTransform4x3()` for eight points
+static inline __m256 nomathTransform8x3(const Matrix *m, int j, __m256 x, __m256 y, __m256 z)
+{
+    __m256 result = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m->elements[j])),
+            _mm256_mul_ps(y, _mm256_set1_ps(m->elements[4 + j])));
+    result = _mm256_add_ps(result, _mm256_mul_ps(z, _mm256_set1_ps(m->elements[8 + j])));
+    return _mm256_add_ps(result, _mm256_set1_ps(m->elements[12 + j]));
+}
+
+static inline __m256 nomathTransform8x2(const Matrix *m, int j, __m256 x, __m256 y)
+{
+    __m256 result = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m->elements[j])),
+            _mm256_mul_ps(y, _mm256_set1_ps(m->elements[4 + j])));
+    return _mm256_add_ps(result, _mm256_set1_ps(m->elements[12 + j]));
+}
+
+// `nomathSplitPoints()` on two groups of four points at once, one in each half
+static inline void nomathSplitPoints8(__m256 a, __m256 b, __m256 c, __m256 *x, __m256 *y, __m256 *z)
+{
+    *x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    *y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void nomathMergePoints8(__m256 x, __m256 y, __m256 z, __m256 *a, __m256 *b, __m256 *c)
+{
+    *a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    *c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline __m256 nomathLoadHalves(const float *low, const float *high)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+}
+
+static inline void nomathStoreHalves(float *low, float *high, __m256 v)
+{
+    _mm_storeu_ps(low, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(high, _mm256_extractf128_ps(v, 1));
+}
+#endif
+#elif defined(NOMATH_NEON)
+static inline float32x4_t nomathRowTimesRows(float32x4_t row, float32x4_t rows0, float32x4_t rows1,
+        float32x4_t rows2, float32x4_t rows3)
+{
+    float32x4_t result = vmulq_lane_f32(rows0, vget_low_f32(row), 0);
+    result = vmlaq_lane_f32(result, rows1, vget_low_f32(row), 1);
+    result = vmlaq_lane_f32(result, rows2, vget_high_f32(row), 0);
+    result = vmlaq_lane_f32(result, rows3, vget_high_f32(row), 1);
+    return result;
+}
+
+static inline float32x4_t nomathRowTimesMatrix(float32x4_t row, const Matrix *m)
+{
+    return nomathRowTimesRows(row, vld1q_f32(m->rows[0].elements), vld1q_f32(m->rows[1].elements),
+            vld1q_f32(m->rows[2].elements), vld1q_f32(m->rows[3].elements));
+}
+
+static inline float32x4_t nomathTransform4x3(const Matrix *m, int j, float32x4_t x, float32x4_t y, float32x4_t z)
+{
+    float32x4_t result = vmlaq_n_f32(vdupq_n_f32(m->elements[12 + j]), x, m->elements[j]);
+    result = vmlaq_n_f32(result, y, m->elements[4 + j]);
+    return vmlaq_n_f32(result, z, m->elements[8 + j]);
+}
+
+static inline float32x4_t nomathTransform4x2(const Matrix *m, int j, float32x4_t x, float32x4_t y)
+{
+    float32x4_t result = vmlaq_n_f32(vdupq_n_f32(m->elements[12 + j]), x, m->elements[j]);
+    return vmlaq_n_f32(result, y, m->elements[4 + j]);
+}
+
+static inline float nomathSum(float32x4_t v)
+{
+    float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+}
+#endif
+
 Vector2 Vector2Add(Vector2 a, Vector2 b)
 {
     return CLITERAL(Vector2){ .x=(a.x + b.x), .y=(a.y + b.y) };
@@ -205,22 +398,44 @@ Vector3 Vector3Cross(Vector3 a, Vector3 b)
 
 Vector4 Vector4Add(Vector4 a, Vector4 b)
 {
+#if defined(NOMATH_SSE)
+    _mm_storeu_ps(a.elements, _mm_add_ps(_mm_loadu_ps(a.elements), _mm_loadu_ps(b.elements)));
+    return a;
+#elif defined(NOMATH_NEON)
+    vst1q_f32(a.elements, vaddq_f32(vld1q_f32(a.elements), vld1q_f32(b.elements)));
+    return a;
+#else
     return CLITERAL(Vector4){ .x=(a.x + b.x), .y=(a.y + b.y), .z=(a.z + b.z), .w=(a.w + b.w) };
+#endif
 }
 
 Vector4 Vector4Sub(Vector4 a, Vector4 b)
 {
+#if defined(NOMATH_SSE)
+    _mm_storeu_ps(a.elements, _mm_sub_ps(_mm_loadu_ps(a.elements), _mm_loadu_ps(b.elements)));
+    return a;
+#elif defined(NOMATH_NEON)
+    vst1q_f32(a.elements, vsubq_f32(vld1q_f32(a.elements), vld1q_f32(b.elements)));
+    return a;
+#else
     return CLITERAL(Vector4){ .x=(a.x - b.x), .y=(a.y - b.y), .z=(a.z - b.z), .w=(a.w - b.w) };
+#endif
 }
 
 float Vector4Dot(Vector4 a, Vector4 b)
 {
+#if defined(NOMATH_SSE)
+    return nomathSum(_mm_mul_ps(_mm_loadu_ps(a.elements), _mm_loadu_ps(b.elements)));
+#elif defined(NOMATH_NEON)
+    return nomathSum(vmulq_f32(vld1q_f32(a.elements), vld1q_f32(b.elements)));
+#else
     return ((a.x*b.x) + (a.y*b.y) + (a.z*b.z) + (a.w*b.w));
+#endif
 }
 
 float Vector4LengthSqr(Vector4 a)
 {
-    return ((a.x*a.x) + (a.y*a.y) + (a.z*a.z) + (a.w*a.w));
+    return Vector4Dot(a, a);
 }
 
 float Vector4Length(Vector4 a)
@@ -233,13 +448,254 @@ Vector4 Vector4Normalize(Vector4 a)
     float length = Vector4Length(a);
     if (length == 0.0f) length = 1.0f;
     float ilength = 1.0f/length;
+#if defined(NOMATH_SSE)
+    _mm_storeu_ps(a.elements, _mm_mul_ps(_mm_loadu_ps(a.elements), _mm_set1_ps(ilength)));
+#elif defined(NOMATH_NEON)
+    vst1q_f32(a.elements, vmulq_n_f32(vld1q_f32(a.elements), ilength));
+#else
     a.x *= ilength;
     a.y *= ilength;
     a.z *= ilength;
     a.w *= ilength;
+#endif
     return a;
 }
 
+Vector4 Vector4Transform(Vector4 v, Matrix m)
+{
+#if defined(NOMATH_SSE)
+    _mm_storeu_ps(v.elements, nomathRowTimesMatrix(_mm_loadu_ps(v.elements), &m));
+    return v;
+#elif defined(NOMATH_NEON)
+    vst1q_f32(v.elements, nomathRowTimesMatrix(vld1q_f32(v.elements), &m));
+    return v;
+#else
+    Vector4 result;
+    for(int j = 0; j < 4; ++j) {
+        result.elements[j] = v.x*m.elements[j] + v.y*m.elements[4 + j] +
+            v.z*m.elements[8 + j] + v.w*m.elements[12 + j];
+    }
+    return result;
+#endif
+}
+
+Vector3 Vector3Transform(Vector3 v, Matrix m)
+{
+    Vector4 result = Vector4Transform(CLITERAL(Vector4){ .x=v.x, .y=v.y, .z=v.z, .w=1.0f }, m);
+    return CLITERAL(Vector3){ .x=result.x, .y=result.y, .z=result.z };
+}
+
+Vector2 Vector2Transform(Vector2 v, Matrix m)
+{
+    return CLITERAL(Vector2){
+        .x = v.x*m.elements[0] + v.y*m.elements[4] + m.elements[12],
+        .y = v.x*m.elements[1] + v.y*m.elements[5] + m.elements[13],
+    };
+}
+
+/**
+ * The point kernels work on a copy of the matrix, stores through `out` could alias `*m`
+ * and would reload its elements every iteration otherwise.
+ * Each block of points is loaded before any of it is stored, which is what lets `out` be `in`.
+ */
+void TransformPoints2D(const Matrix *m, const Vector2 *in, Vector2 *out, size_t count)
+{
+    const Matrix matrix = *m;
+    const float *e = matrix.elements;
+    size_t i = 0;
+#if defined(NOMATH_AVX)
+    // x0 x0 x1 x1 ... times the first column pair, y0 y0 y1 y1 ... times the second
+    __m256 columns0 = _mm256_setr_ps(e[0], e[1], e[0], e[1], e[0], e[1], e[0], e[1]);
+    __m256 columns1 = _mm256_setr_ps(e[4], e[5], e[4], e[5], e[4], e[5], e[4], e[5]);
+    __m256 columns3 = _mm256_setr_ps(e[12], e[13], e[12], e[13], e[12], e[13], e[12], e[13]);
+    for(; i + 4 <= count; i += 4) {
+        __m256 points = _mm256_loadu_ps(in[i].elements);
+        __m256 result = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(points, points, 0xa0), columns0),
+                _mm256_mul_ps(_mm256_shuffle_ps(points, points, 0xf5), columns1));
+        _mm256_storeu_ps(out[i].elements, _mm256_add_ps(result, columns3));
+    }
+#endif
+#if defined(NOMATH_SSE)
+    __m128 pairs0 = _mm_setr_ps(e[0], e[1], e[0], e[1]);
+    __m128 pairs1 = _mm_setr_ps(e[4], e[5], e[4], e[5]);
+    __m128 pairs3 = _mm_setr_ps(e[12], e[13], e[12], e[13]);
+    for(; i + 2 <= count; i += 2) {
+        __m128 points = _mm_loadu_ps(in[i].elements);
+        __m128 result = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(points, points, 0xa0), pairs0),
+                _mm_mul_ps(_mm_shuffle_ps(points, points, 0xf5), pairs1));
+        _mm_storeu_ps(out[i].elements, _mm_add_ps(result, pairs3));
+    }
+#elif defined(NOMATH_NEON)
+    for(; i + 4 <= count; i += 4) {
+        float32x4x2_t points = vld2q_f32(in[i].elements);
+        float32x4x2_t result;
+        result.val[0] = nomathTransform4x2(&matrix, 0, points.val[0], points.val[1]);
+        result.val[1] = nomathTransform4x2(&matrix, 1, points.val[0], points.val[1]);
+        vst2q_f32(out[i].elements, result);
+    }
+#endif
+    for(; i < count; ++i) {
+        Vector2 v = in[i];
+        out[i].x = v.x*e[0] + v.y*e[4] + e[12];
+        out[i].y = v.x*e[1] + v.y*e[5] + e[13];
+    }
+}
+
+void TransformPoints3D(const Matrix *m, const Vector3 *in, Vector3 *out, size_t count)
+{
+    const Matrix matrix = *m;
+    const float *e = matrix.elements;
+    size_t i = 0;
+#if defined(NOMATH_AVX)
+    for(; i + 8 <= count; i += 8) {
+        const float *p = in[i].elements;
+        __m256 x, y, z, a, b, c;
+        nomathSplitPoints8(nomathLoadHalves(p, p + 12), nomathLoadHalves(p + 4, p + 16), nomathLoadHalves(p + 8, p + 20), &x, &y, &z);
+        nomathMergePoints8(nomathTransform8x3(&matrix, 0, x, y, z), nomathTransform8x3(&matrix, 1, x, y, z),
+                nomathTransform8x3(&matrix, 2, x, y, z), &a, &b, &c);
+        float *q = out[i].elements;
+        nomathStoreHalves(q, q + 12, a);
+        nomathStoreHalves(q + 4, q + 16, b);
+        nomathStoreHalves(q + 8, q + 20, c);
+    }
+#endif
+#if defined(NOMATH_SSE)
+    for(; i + 4 <= count; i += 4) {
+        const float *p = in[i].elements;
+        __m128 x, y, z, a, b, c;
+        nomathSplitPoints(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), &x, &y, &z);
+        nomathMergePoints(nomathTransform4x3(&matrix, 0, x, y, z), nomathTransform4x3(&matrix, 1, x, y, z),
+                nomathTransform4x3(&matrix, 2, x, y, z), &a, &b, &c);
+        float *q = out[i].elements;
+        _mm_storeu_ps(q, a);
+        _mm_storeu_ps(q + 4, b);
+        _mm_storeu_ps(q + 8, c);
+    }
+#elif defined(NOMATH_NEON)
+    for(; i + 4 <= count; i += 4) {
+        float32x4x3_t points = vld3q_f32(in[i].elements);
+        float32x4x3_t result;
+        for(int j = 0; j < 3; ++j) result.val[j] = nomathTransform4x3(&matrix, j, points.val[0], points.val[1], points.val[2]);
+        vst3q_f32(out[i].elements, result);
+    }
+#endif
+    for(; i < count; ++i) {
+        Vector3 v = in[i];
+        out[i].x = v.x*e[0] + v.y*e[4] + v.z*e[8] + e[12];
+        out[i].y = v.x*e[1] + v.y*e[5] + v.z*e[9] + e[13];
+        out[i].z = v.x*e[2] + v.y*e[6] + v.z*e[10] + e[14];
+    }
+}
+
+void TransformPoints4D(const Matrix *m, const Vector4 *in, Vector4 *out, size_t count)
+{
+    const Matrix matrix = *m;
+    size_t i = 0;
+#if defined(NOMATH_AVX)
+    __m256 rows0 = _mm256_broadcast_ps((const __m128 *)matrix.rows[0].elements);
+    __m256 rows1 = _mm256_broadcast_ps((const __m128 *)matrix.rows[1].elements);
+    __m256 rows2 = _mm256_broadcast_ps((const __m128 *)matrix.rows[2].elements);
+    __m256 rows3 = _mm256_broadcast_ps((const __m128 *)matrix.rows[3].elements);
+    for(; i + 2 <= count; i += 2) {
+        _mm256_storeu_ps(out[i].elements,
+                nomathRowPairTimesMatrix(_mm256_loadu_ps(in[i].elements), rows0, rows1, rows2, rows3));
+    }
+#endif
+#if defined(NOMATH_SSE)
+    __m128 row0 = _mm_loadu_ps(matrix.rows[0].elements), row1 = _mm_loadu_ps(matrix.rows[1].elements);
+    __m128 row2 = _mm_loadu_ps(matrix.rows[2].elements), row3 = _mm_loadu_ps(matrix.rows[3].elements);
+    for(; i < count; ++i) {
+        _mm_storeu_ps(out[i].elements, nomathRowTimesRows(_mm_loadu_ps(in[i].elements), row0, row1, row2, row3));
+    }
+#elif defined(NOMATH_NEON)
+    float32x4_t row0 = vld1q_f32(matrix.rows[0].elements), row1 = vld1q_f32(matrix.rows[1].elements);
+    float32x4_t row2 = vld1q_f32(matrix.rows[2].elements), row3 = vld1q_f32(matrix.rows[3].elements);
+    for(; i < count; ++i) {
+        vst1q_f32(out[i].elements, nomathRowTimesRows(vld1q_f32(in[i].elements), row0, row1, row2, row3));
+    }
+#else
+    for(; i < count; ++i) out[i] = Vector4Transform(in[i], matrix);
+#endif
+}
+
+void TransformPoints2DSoA(const Matrix *m, const float *inX, const float *inY, float *outX, float *outY, size_t count)
+{
+    const Matrix matrix = *m;
+    const float *e = matrix.elements;
+    size_t i = 0;
+#if defined(NOMATH_AVX)
+    for(; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(&inX[i]), y = _mm256_loadu_ps(&inY[i]);
+        __m256 resultX = nomathTransform8x2(&matrix, 0, x, y);
+        _mm256_storeu_ps(&outY[i], nomathTransform8x2(&matrix, 1, x, y));
+        _mm256_storeu_ps(&outX[i], resultX);
+    }
+#endif
+#if defined(NOMATH_SSE)
+    for(; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&inX[i]), y = _mm_loadu_ps(&inY[i]);
+        __m128 resultX = nomathTransform4x2(&matrix, 0, x, y);
+        _mm_storeu_ps(&outY[i], nomathTransform4x2(&matrix, 1, x, y));
+        _mm_storeu_ps(&outX[i], resultX);
+    }
+#elif defined(NOMATH_NEON)
+    for(; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(&inX[i]), y = vld1q_f32(&inY[i]);
+        float32x4_t resultX = nomathTransform4x2(&matrix, 0, x, y);
+        vst1q_f32(&outY[i], nomathTransform4x2(&matrix, 1, x, y));
+        vst1q_f32(&outX[i], resultX);
+    }
+#endif
+    for(; i < count; ++i) {
+        float x = inX[i], y = inY[i];
+        outX[i] = x*e[0] + y*e[4] + e[12];
+        outY[i] = x*e[1] + y*e[5] + e[13];
+    }
+}
+
+void TransformPoints3DSoA(const Matrix *m, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t count)
+{
+    const Matrix matrix = *m;
+    const float *e = matrix.elements;
+    size_t i = 0;
+#if defined(NOMATH_AVX)
+    for(; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(&inX[i]), y = _mm256_loadu_ps(&inY[i]), z = _mm256_loadu_ps(&inZ[i]);
+        __m256 resultX = nomathTransform8x3(&matrix, 0, x, y, z);
+        __m256 resultY = nomathTransform8x3(&matrix, 1, x, y, z);
+        _mm256_storeu_ps(&outZ[i], nomathTransform8x3(&matrix, 2, x, y, z));
+        _mm256_storeu_ps(&outX[i], resultX);
+        _mm256_storeu_ps(&outY[i], resultY);
+    }
+#endif
+#if defined(NOMATH_SSE)
+    for(; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&inX[i]), y = _mm_loadu_ps(&inY[i]), z = _mm_loadu_ps(&inZ[i]);
+        __m128 resultX = nomathTransform4x3(&matrix, 0, x, y, z);
+        __m128 resultY = nomathTransform4x3(&matrix, 1, x, y, z);
+        _mm_storeu_ps(&outZ[i], nomathTransform4x3(&matrix, 2, x, y, z));
+        _mm_storeu_ps(&outX[i], resultX);
+        _mm_storeu_ps(&outY[i], resultY);
+    }
+#elif defined(NOMATH_NEON)
+    for(; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(&inX[i]), y = vld1q_f32(&inY[i]), z = vld1q_f32(&inZ[i]);
+        float32x4_t resultX = nomathTransform4x3(&matrix, 0, x, y, z);
+        float32x4_t resultY = nomathTransform4x3(&matrix, 1, x, y, z);
+        vst1q_f32(&outZ[i], nomathTransform4x3(&matrix, 2, x, y, z));
+        vst1q_f32(&outX[i], resultX);
+        vst1q_f32(&outY[i], resultY);
+    }
+#endif
+    for(; i < count; ++i) {
+        float x = inX[i], y = inY[i], z = inZ[i];
+        outX[i] = x*e[0] + y*e[4] + z*e[8] + e[12];
+        outY[i] = x*e[1] + y*e[5] + z*e[9] + e[13];
+        outZ[i] = x*e[2] + y*e[6] + z*e[10] + e[14];
+    }
+}
+
 Matrix MatrixCreate(float eye)
 {
     Matrix result = CLITERAL(Matrix){0};
@@ -252,21 +708,55 @@ Matrix MatrixCreate(float eye)
 
 Matrix MatrixAdd(Matrix a, Matrix b)
 {
+#if defined(NOMATH_SSE)
+    for(int i=0; i<16; i+=4)
+        _mm_storeu_ps(&a.elements[i], _mm_add_ps(_mm_loadu_ps(&a.elements[i]), _mm_loadu_ps(&b.elements[i])));
+#elif defined(NOMATH_NEON)
+    for(int i=0; i<16; i+=4)
+        vst1q_f32(&a.elements[i], vaddq_f32(vld1q_f32(&a.elements[i]), vld1q_f32(&b.elements[i])));
+#else
     for(int i=0; i<16; ++i)
         a.elements[i] += b.elements[i];
+#endif
     return a;
 }
 
 Matrix MatrixSub(Matrix a, Matrix b)
 {
+#if defined(NOMATH_SSE)
+    for(int i=0; i<16; i+=4)
+        _mm_storeu_ps(&a.elements[i], _mm_sub_ps(_mm_loadu_ps(&a.elements[i]), _mm_loadu_ps(&b.elements[i])));
+#elif defined(NOMATH_NEON)
+    for(int i=0; i<16; i+=4)
+        vst1q_f32(&a.elements[i], vsubq_f32(vld1q_f32(&a.elements[i]), vld1q_f32(&b.elements[i])));
+#else
     for(int i=0; i<16; ++i)
         a.elements[i] -= b.elements[i];
+#endif
     return a;
 }
 
+// Row i of the result is row i of `a` times `b`, which the SIMD paths add up from the rows of `b`
 Matrix MatrixDot(Matrix a, Matrix b)
 {
     Matrix result;
+#if defined(NOMATH_AVX)
+    // Two rows of `a` at once, each 128 bit half against its own copy of the rows of `b`
+    __m256 rows0 = _mm256_broadcast_ps((const __m128 *)b.rows[0].elements);
+    __m256 rows1 = _mm256_broadcast_ps((const __m128 *)b.rows[1].elements);
+    __m256 rows2 = _mm256_broadcast_ps((const __m128 *)b.rows[2].elements);
+    __m256 rows3 = _mm256_broadcast_ps((const __m128 *)b.rows[3].elements);
+    _mm256_storeu_ps(&result.elements[0],
+            nomathRowPairTimesMatrix(_mm256_loadu_ps(&a.elements[0]), rows0, rows1, rows2, rows3));
+    _mm256_storeu_ps(&result.elements[8],
+            nomathRowPairTimesMatrix(_mm256_loadu_ps(&a.elements[8]), rows0, rows1, rows2, rows3));
+#elif defined(NOMATH_SSE)
+    for(int i = 0; i < 4; ++i)
+        _mm_storeu_ps(result.rows[i].elements, nomathRowTimesMatrix(_mm_loadu_ps(a.rows[i].elements), &b));
+#elif defined(NOMATH_NEON)
+    for(int i = 0; i < 4; ++i)
+        vst1q_f32(result.rows[i].elements, nomathRowTimesMatrix(vld1q_f32(a.rows[i].elements), &b));
+#else
     for(int i = 0; i < 4; ++i) {
         for(int j = 0; j < 4; ++j) {            
             result.elements[i * 4 + j] = 0.0f;
@@ -277,6 +767,7 @@ Matrix MatrixDot(Matrix a, Matrix b)
             }
         }
     }
+#endif
     return result;
 }
 
@@ -308,63 +799,54 @@ Matrix MatrixPerspective(float fovRadians, float aspectRatio, float near, float
     return res;
 }
 
+// The transformations below are `MatrixDot()` with their matrix written out, only the columns it changes are computed
+
 Matrix MatrixTranslate(Matrix a, Vector3 v3)
 {
-    Matrix transformation_matrix = MatrixCreate(1.0f);
-    transformation_matrix.elements[12]  = v3.x;
-    transformation_matrix.elements[13]  = v3.y;
-    transformation_matrix.elements[14] = v3.z;
-    return MatrixDot(a, transformation_matrix);
+    for(int i = 0; i < 4; ++i) {
+        float w = a.elements[i * 4 + 3];
+        a.elements[i * 4 + 0] += w * v3.x;
+        a.elements[i * 4 + 1] += w * v3.y;
+        a.elements[i * 4 + 2] += w * v3.z;
+    }
+    return a;
 }
 
 Matrix MatrixScale(Matrix a, Vector3 v3)
 {
-    Matrix transformation_matrix = MatrixCreate(1.0f);
-    transformation_matrix.elements[0] = v3.x;
-    transformation_matrix.elements[5] = v3.y;
-    transformation_matrix.elements[10] = v3.z;
+    for(int i = 0; i < 4; ++i) {
+        a.elements[i * 4 + 0] *= v3.x;
+        a.elements[i * 4 + 1] *= v3.y;
+        a.elements[i * 4 + 2] *= v3.z;
+    }
+    return a;
+}
 
-    return MatrixDot(a, transformation_matrix);
+// Columns `p` and `q` of `a` turned into each other by the angle of cosine `c` and sine `s`
+static inline Matrix nomathRotateColumns(Matrix a, int p, int q, float c, float s)
+{
+    for(int i = 0; i < 4; ++i) {
+        float ap = a.elements[i * 4 + p];
+        float aq = a.elements[i * 4 + q];
+        a.elements[i * 4 + p] = ap * c - aq * s;
+        a.elements[i * 4 + q] = ap * s + aq * c;
+    }
+    return a;
 }
 
 Matrix MatrixRotateX(Matrix a, float angleRadians)
 {
-    Matrix transformation_matrix = MatrixCreate(1.0f);
-    float s = sin(angleRadians);
-    float c = cos(angleRadians);
-    transformation_matrix.elements[5] = c;
-    transformation_matrix.elements[6] = s;
-    transformation_matrix.elements[9] = -s;
-    transformation_matrix.elements[10] = c;
-    return MatrixDot(a, transformation_matrix);
+    return nomathRotateColumns(a, 1, 2, cos(angleRadians), sin(angleRadians));
 }
 
 Matrix MatrixRotateY(Matrix a, float angleRadians)
 {
-    Matrix transformation_matrix = MatrixCreate(1.0f);
-    float s = sin(angleRadians);
-    float c = cos(angleRadians);
-
-    transformation_matrix.elements[0] = c;
-    transformation_matrix.elements[2] = -s;
-    transformation_matrix.elements[8] = s;
-    transformation_matrix.elements[10] = c;
-
-    return MatrixDot(a, transformation_matrix);
+    return nomathRotateColumns(a, 2, 0, cos(angleRadians), sin(angleRadians));
 }
 
 Matrix MatrixRotateZ(Matrix a, float angleRadians)
 {
-    Matrix transformation_matrix = MatrixCreate(1.0f);
-    float s = sin(angleRadians);
-    float c = cos(angleRadians);
-
-    transformation_matrix.elements[0] = c;
-    transformation_matrix.elements[1] = -s;
-    transformation_matrix.elements[4] = s;
-    transformation_matrix.elements[5] = c;
-
-    return MatrixDot(a, transformation_matrix);
+    return nomathRotateColumns(a, 1, 0, cos(angleRadians), sin(angleRadians));
 }
 
 Matrix MatrixLookAt(Vector3 pos, Vector3 target, Vector3 up)
@@ -0,0 +1,238 @@
+#ifndef NOQOI_H_
+#define NOQOI_H_
+
+// "Quite OK Image" format codec, see https://qoiformat.org/qoi-specification.pdf
+// The codec never allocates, callers hand in the destination buffers
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING_SIZE 8
+#ifndef QOI_PIXELS_MAX
+    #define QOI_PIXELS_MAX 400000000u // Larger headers are rejected, 2GB of RGBA pixels is no sane image
+#endif
+
+typedef struct QoiDesc {
+    uint32_t width, height;
+    uint8_t channels; // 3 = RGB, 4 = RGBA
+    uint8_t colorspace; // 0 = sRGB with linear alpha, 1 = all channels linear
+} QoiDesc;
+
+bool QoiIsImage(const void *data, size_t size);
+bool QoiReadHeader(const void *data, size_t size, QoiDesc *desc);
+// Decode into `pixels`, `desc.width*desc.height*desc.channels` bytes with rows top to bottom unless flipped
+bool QoiDecode(const void *data, size_t size, void *pixels, size_t pixelsSize, bool flipVertically);
+size_t QoiMaxEncodedSize(QoiDesc desc);
+// Returns the encoded size, 0 if `out` is too small
+size_t QoiEncode(const void *pixels, QoiDesc desc, void *out, size_t outCapacity);
+
+#endif // NOQOI_H_
+
+#ifdef NOQOI_IMPLEMENTATION
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xc0
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+#define QOI_MASK_2   0xc0
+
+typedef union _QoiPixel {
+    struct { uint8_t r, g, b, a; } rgba;
+    uint32_t value;
+} _QoiPixel;
+
+static inline uint32_t qoiHash(_QoiPixel px)
+{
+    return (px.rgba.r*3 + px.rgba.g*5 + px.rgba.b*7 + px.rgba.a*11) % 64;
+}
+
+static inline uint32_t qoiRead32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void qoiWrite32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+bool QoiIsImage(const void *data, size_t size)
+{
+    const uint8_t *bytes = data;
+    return size >= QOI_HEADER_SIZE && bytes[0] == 'q' && bytes[1] == 'o' && bytes[2] == 'i' && bytes[3] == 'f';
+}
+
+bool QoiReadHeader(const void *data, size_t size, QoiDesc *desc)
+{
+    if(!QoiIsImage(data, size)) return false;
+    const uint8_t *bytes = data;
+    desc->width = qoiRead32(bytes + 4);
+    desc->height = qoiRead32(bytes + 8);
+    desc->channels = bytes[12];
+    desc->colorspace = bytes[13];
+    if(desc->width == 0 || desc->height == 0) return false;
+    if(desc->height >= QOI_PIXELS_MAX/desc->width) return false;
+    if(desc->channels < 3 || desc->channels > 4) return false;
+    return true;
+}
+
+bool QoiDecode(const void *data, size_t size, void *pixels, size_t pixelsSize, bool flipVertically)
+{
+    QoiDesc desc;
+    if(!QoiReadHeader(data, size, &desc)) return false;
+    uint32_t channels = desc.channels;
+    size_t rowSize = (size_t)desc.width*channels;
+    if(pixelsSize < rowSize*desc.height) return false;
+
+    const uint8_t *bytes = data;
+    size_t p = QOI_HEADER_SIZE;
+    size_t chunksEnd = size - QOI_PADDING_SIZE;
+    _QoiPixel index[64] = {0};
+    _QoiPixel px = { .rgba = { 0, 0, 0, 255 } };
+    uint32_t run = 0;
+
+    for(uint32_t y = 0; y < desc.height; ++y) {
+        uint8_t *row = (uint8_t *)pixels + rowSize*(flipVertically ? desc.height - 1 - y : y);
+        for(uint32_t x = 0; x < desc.width; ++x) {
+            if(run > 0) {
+                run -= 1;
+            } else if(p < chunksEnd) {
+                uint8_t b1 = bytes[p++];
+                if(b1 == QOI_OP_RGB) {
+                    if(p + 3 > chunksEnd) return false;
+                    px.rgba.r = bytes[p++];
+                    px.rgba.g = bytes[p++];
+                    px.rgba.b = bytes[p++];
+                } else if(b1 == QOI_OP_RGBA) {
+                    if(p + 4 > chunksEnd) return false;
+                    px.rgba.r = bytes[p++];
+                    px.rgba.g = bytes[p++];
+                    px.rgba.b = bytes[p++];
+                    px.rgba.a = bytes[p++];
+                } else if((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+                    px = index[b1];
+                } else if((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+                    px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+                    px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+                    px.rgba.b += (b1 & 0x03) - 2;
+                } else if((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+                    if(p + 1 > chunksEnd) return false;
+                    uint8_t b2 = bytes[p++];
+                    int vg = (b1 & 0x3f) - 32;
+                    px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0f);
+                    px.rgba.g += vg;
+                    px.rgba.b += vg - 8 + (b2 & 0x0f);
+                } else {
+                    run = b1 & 0x3f;
+                }
+                index[qoiHash(px)] = px;
+            } else {
+                return false; // Truncated stream
+            }
+
+            uint8_t *dst = row + (size_t)x*channels;
+            dst[0] = px.rgba.r;
+            dst[1] = px.rgba.g;
+            dst[2] = px.rgba.b;
+            if(channels == 4) dst[3] = px.rgba.a;
+        }
+    }
+    return true;
+}
+
+size_t QoiMaxEncodedSize(QoiDesc desc)
+{
+    return (size_t)desc.width*desc.height*(desc.channels + 1) + QOI_HEADER_SIZE + QOI_PADDING_SIZE;
+}
+
+size_t QoiEncode(const void *pixels, QoiDesc desc, void *out, size_t outCapacity)
+{
+    if(desc.width == 0 || desc.height == 0 || desc.channels < 3 || desc.channels > 4) return 0;
+    if(desc.height >= QOI_PIXELS_MAX/desc.width) return 0;
+    if(outCapacity < QoiMaxEncodedSize(desc)) return 0;
+
+    uint8_t *bytes = out;
+    const uint8_t *src = pixels;
+    size_t p = 0;
+    bytes[p++] = 'q';
+    bytes[p++] = 'o';
+    bytes[p++] = 'i';
+    bytes[p++] = 'f';
+    qoiWrite32(bytes + p, desc.width);
+    p += 4;
+    qoiWrite32(bytes + p, desc.height);
+    p += 4;
+    bytes[p++] = desc.channels;
+    bytes[p++] = desc.colorspace;
+
+    _QoiPixel index[64] = {0};
+    _QoiPixel prev = { .rgba = { 0, 0, 0, 255 } };
+    _QoiPixel px = prev;
+    uint32_t run = 0;
+    size_t pixelCount = (size_t)desc.width*desc.height;
+    for(size_t i = 0; i < pixelCount; ++i) {
+        const uint8_t *s = src + i*desc.channels;
+        px.rgba.r = s[0];
+        px.rgba.g = s[1];
+        px.rgba.b = s[2];
+        if(desc.channels == 4) px.rgba.a = s[3];
+
+        if(px.value == prev.value) {
+            run += 1;
+            if(run == 62 || i == pixelCount - 1) {
+                bytes[p++] = QOI_OP_RUN | (uint8_t)(run - 1);
+                run = 0;
+            }
+            continue;
+        }
+        if(run > 0) {
+            bytes[p++] = QOI_OP_RUN | (uint8_t)(run - 1);
+            run = 0;
+        }
+
+        uint32_t hash = qoiHash(px);
+        if(index[hash].value == px.value) {
+            bytes[p++] = QOI_OP_INDEX | (uint8_t)hash;
+        } else {
+            index[hash] = px;
+            if(px.rgba.a == prev.rgba.a) {
+                int8_t vr = (int8_t)(px.rgba.r - prev.rgba.r);
+                int8_t vg = (int8_t)(px.rgba.g - prev.rgba.g);
+                int8_t vb = (int8_t)(px.rgba.b - prev.rgba.b);
+                int8_t vgr = (int8_t)(vr - vg);
+                int8_t vgb = (int8_t)(vb - vg);
+                if(vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                    bytes[p++] = QOI_OP_DIFF | (uint8_t)((vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                } else if(vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8) {
+                    bytes[p++] = QOI_OP_LUMA | (uint8_t)(vg + 32);
+                    bytes[p++] = (uint8_t)((vgr + 8) << 4 | (vgb + 8));
+                } else {
+                    bytes[p++] = QOI_OP_RGB;
+                    bytes[p++] = px.rgba.r;
+                    bytes[p++] = px.rgba.g;
+                    bytes[p++] = px.rgba.b;
+                }
+            } else {
+                bytes[p++] = QOI_OP_RGBA;
+                bytes[p++] = px.rgba.r;
+                bytes[p++] = px.rgba.g;
+                bytes[p++] = px.rgba.b;
+                bytes[p++] = px.rgba.a;
+            }
+        }
+        prev = px;
+    }
+
+    for(int i = 0; i < QOI_PADDING_SIZE - 1; ++i) bytes[p++] = 0;
+    bytes[p++] = 1;
+    return p;
+}
+
+#endif // NOQOI_IMPLEMENTATION
@@ -0,0 +1,62 @@
+// Convert PNG, JPG, BMP, TGA, ... images to QOI for `LoadTextureFromFile()`
+// Usage: qoiconv <input> <output.qoi> [<input> <output.qoi> ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../src/vendors/stb/stb_image.h"
+
+#define NOQOI_IMPLEMENTATION
+#include "../src/noqoi.h"
+
+static bool convertImage(const char *inputPath, const char *outputPath)
+{
+    int width, height, compAmount;
+    if(!stbi_info(inputPath, &width, &height, &compAmount)) {
+        fprintf(stderr, "ERROR: Could not read \"%s\": %s\n", inputPath, stbi_failure_reason());
+        return false;
+    }
+    // QOI only stores RGB and RGBA, gray images are expanded
+    int channels = (compAmount == 2 || compAmount == 4) ? 4 : 3;
+    stbi_uc *pixels = stbi_load(inputPath, &width, &height, &compAmount, channels);
+    if(!pixels) {
+        fprintf(stderr, "ERROR: Could not decode \"%s\": %s\n", inputPath, stbi_failure_reason());
+        return false;
+    }
+
+    QoiDesc desc = { .width = (uint32_t)width, .height = (uint32_t)height, .channels = (uint8_t)channels, .colorspace = 0 };
+    size_t capacity = QoiMaxEncodedSize(desc);
+    uint8_t *encoded = malloc(capacity);
+    size_t encodedSize = encoded ? QoiEncode(pixels, desc, encoded, capacity) : 0;
+    stbi_image_free(pixels);
+    if(encodedSize == 0) {
+        fprintf(stderr, "ERROR: Could not encode \"%s\"\n", inputPath);
+        free(encoded);
+        return false;
+    }
+
+    FILE *f = fopen(outputPath, "wb");
+    bool result = f && fwrite(encoded, 1, encodedSize, f) == encodedSize;
+    if(f) fclose(f);
+    free(encoded);
+    if(!result) {
+        fprintf(stderr, "ERROR: Could not write \"%s\"\n", outputPath);
+        return false;
+    }
+    printf("%s -> %s (%dx%d, %d channels, %zu bytes)\n", inputPath, outputPath, width, height, channels, encodedSize);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if(argc < 3 || (argc - 1) % 2 != 0) {
+        fprintf(stderr, "Usage: %s <input> <output.qoi> [<input> <output.qoi> ...]\n", argv[0]);
+        return 1;
+    }
+    int failed = 0;
+    for(int i = 1; i + 1 < argc; i += 2) {
+        if(!convertImage(argv[i], argv[i + 1])) failed += 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
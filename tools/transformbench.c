@@ -0,0 +1,164 @@
+// Time the `TransformPoints*()` kernels of nomath.h against a loop of `Vector*Transform()` calls
+// Usage: transformbench [<point count> [<repeats>]]
+// The largest difference is 0 on x86 when built with -ffp-contract=off, NEON kernels sum in another order
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NOMATH_IMPLEMENTATION
+#include "../src/nomath.h"
+
+static size_t pointCount = 100000;
+static int repeats = 200;
+
+static double getSeconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+static float randomFloat(void)
+{
+    return (float)rand()/(float)RAND_MAX*200.0f - 100.0f;
+}
+
+static float largestDifference(const float *a, const float *b, size_t count)
+{
+    float result = 0.0f;
+    for(size_t i = 0; i < count; ++i) {
+        float difference = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+        if(difference > result) result = difference;
+    }
+    return result;
+}
+
+static void report(const char *name, double loopSeconds, double kernelSeconds, float difference)
+{
+    double scale = 1e9/((double)pointCount*repeats);
+    printf("%-10s loop %7.3f ns/point, kernel %7.3f ns/point, %5.2fx, largest difference %g\n",
+            name, loopSeconds*scale, kernelSeconds*scale, loopSeconds/kernelSeconds, difference);
+}
+
+int main(int argc, char **argv)
+{
+    if(argc > 1) pointCount = (size_t)strtoull(argv[1], NULL, 10);
+    if(argc > 2) repeats = atoi(argv[2]);
+    if(pointCount == 0 || repeats <= 0) {
+        fprintf(stderr, "Usage: %s [<point count> [<repeats>]]\n", argv[0]);
+        return 1;
+    }
+#if defined(NOMATH_AVX)
+    const char *path = "AVX";
+#elif defined(NOMATH_SSE)
+    const char *path = "SSE";
+#elif defined(NOMATH_NEON)
+    const char *path = "NEON";
+#else
+    const char *path = "scalar";
+#endif
+    printf("%zu points, %d repeats, %s kernels\n", pointCount, repeats, path);
+
+    Matrix m = MatrixCreate(1.0f);
+    m = MatrixRotateZ(MatrixRotateX(m, 0.5f), 0.3f);
+    m = MatrixTranslate(MatrixScale(m, CLITERAL(Vector3){ .x=2.0f, .y=3.0f, .z=0.5f }), CLITERAL(Vector3){ .x=10.0f, .y=-4.0f, .z=1.0f });
+
+    Vector4 *in = malloc(pointCount*sizeof(Vector4));
+    Vector4 *loopOut = malloc(pointCount*sizeof(Vector4));
+    Vector4 *kernelOut = malloc(pointCount*sizeof(Vector4));
+    float *soa = malloc(pointCount*sizeof(float)*6);
+    if(!in || !loopOut || !kernelOut || !soa) {
+        fprintf(stderr, "ERROR: Could not allocate %zu points\n", pointCount);
+        return 1;
+    }
+    float *x = soa, *y = soa + pointCount, *z = soa + pointCount*2;
+    float *outX = soa + pointCount*3, *outY = soa + pointCount*4, *outZ = soa + pointCount*5;
+    for(size_t i = 0; i < pointCount; ++i) {
+        for(int j = 0; j < 4; ++j) in[i].elements[j] = randomFloat();
+        x[i] = in[i].x;
+        y[i] = in[i].y;
+        z[i] = in[i].z;
+    }
+
+    // The arrays are reused for each dimension, as tightly packed Vector2s and Vector3s
+    double start = getSeconds();
+    for(int r = 0; r < repeats; ++r) {
+        for(size_t i = 0; i < pointCount; ++i) ((Vector2 *)loopOut)[i] = Vector2Transform(((Vector2 *)in)[i], m);
+    }
+    double loopSeconds = getSeconds() - start;
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) TransformPoints2D(&m, (Vector2 *)in, (Vector2 *)kernelOut, pointCount);
+    report("2D", loopSeconds, getSeconds() - start,
+            largestDifference(loopOut[0].elements, kernelOut[0].elements, pointCount*2));
+
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) {
+        for(size_t i = 0; i < pointCount; ++i) ((Vector3 *)loopOut)[i] = Vector3Transform(((Vector3 *)in)[i], m);
+    }
+    loopSeconds = getSeconds() - start;
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) TransformPoints3D(&m, (Vector3 *)in, (Vector3 *)kernelOut, pointCount);
+    report("3D", loopSeconds, getSeconds() - start,
+            largestDifference(loopOut[0].elements, kernelOut[0].elements, pointCount*3));
+
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) {
+        for(size_t i = 0; i < pointCount; ++i) loopOut[i] = Vector4Transform(in[i], m);
+    }
+    loopSeconds = getSeconds() - start;
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) TransformPoints4D(&m, in, kernelOut, pointCount);
+    report("4D", loopSeconds, getSeconds() - start,
+            largestDifference(loopOut[0].elements, kernelOut[0].elements, pointCount*4));
+
+    // The loops stay on arrays of vectors, that is what the data would be without the SoA kernels
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) {
+        for(size_t i = 0; i < pointCount; ++i) {
+            Vector2 result = Vector2Transform(CLITERAL(Vector2){ .x=x[i], .y=y[i] }, m);
+            outX[i] = result.x;
+            outY[i] = result.y;
+        }
+    }
+    loopSeconds = getSeconds() - start;
+    for(size_t i = 0; i < pointCount; ++i) {
+        ((Vector2 *)loopOut)[i] = CLITERAL(Vector2){ .x=outX[i], .y=outY[i] };
+    }
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) TransformPoints2DSoA(&m, x, y, outX, outY, pointCount);
+    double kernelSeconds = getSeconds() - start;
+    for(size_t i = 0; i < pointCount; ++i) {
+        ((Vector2 *)kernelOut)[i] = CLITERAL(Vector2){ .x=outX[i], .y=outY[i] };
+    }
+    report("2D SoA", loopSeconds, kernelSeconds,
+            largestDifference(loopOut[0].elements, kernelOut[0].elements, pointCount*2));
+
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) {
+        for(size_t i = 0; i < pointCount; ++i) {
+            Vector3 result = Vector3Transform(CLITERAL(Vector3){ .x=x[i], .y=y[i], .z=z[i] }, m);
+            outX[i] = result.x;
+            outY[i] = result.y;
+            outZ[i] = result.z;
+        }
+    }
+    loopSeconds = getSeconds() - start;
+    for(size_t i = 0; i < pointCount; ++i) {
+        ((Vector3 *)loopOut)[i] = CLITERAL(Vector3){ .x=outX[i], .y=outY[i], .z=outZ[i] };
+    }
+    start = getSeconds();
+    for(int r = 0; r < repeats; ++r) TransformPoints3DSoA(&m, x, y, z, outX, outY, outZ, pointCount);
+    kernelSeconds = getSeconds() - start;
+    for(size_t i = 0; i < pointCount; ++i) {
+        ((Vector3 *)kernelOut)[i] = CLITERAL(Vector3){ .x=outX[i], .y=outY[i], .z=outZ[i] };
+    }
+    report("3D SoA", loopSeconds, kernelSeconds,
+            largestDifference(loopOut[0].elements, kernelOut[0].elements, pointCount*3));
+
+    free(in);
+    free(loopOut);
+    free(kernelOut);
+    free(soa);
+    return 0;
+}